@@ -12,6 +12,20 @@
 * УДАЛЕНИЕ
 Вычисляем номер корзины и запоминаем итератор, который понадобится нам при удалении. Если встречаем ключ, выводим
 Значение. По итератору лежит нода, у которой next-> это наш элемент. Поэтому с помощью erase_after удаляем с нужной позиции.
+* ПАКЕТНОЕ ПОЛУЧЕНИЕ
+Одновременно ведутся BATCH_GROUP поисков, и они выполняются по очереди маленькими шагами (AMAC): шаг читает корзину
+Или ноду цепочки, предвыбранную (prefetch) на прошлом шаге, и запрашивает предвыборку следующей. Пока память для
+Одного поиска в пути, выполняются шаги остальных, и закончивший поиск сразу уступает место следующему ключу.
+Так промахи кэша по разным ключам перекрываются во времени, а не идут друг за другом.
+* ФИЛЬТР ОТСУТСТВУЮЩИХ КЛЮЧЕЙ
+По желанию перед таблицей ставится считающий фильтр Блума: массив однобайтовых счётчиков и k хеш-функций.
+При вставке нового ключа k счётчиков увеличиваются, при удалении - уменьшаются, поэтому удаление поддерживается.
+Если хотя бы один из k счётчиков ключа равен нулю, ключа точно нет, и get/delete отвечают, не трогая корзины.
+Переполненный счётчик (255) больше не меняется - фильтр может лишь чаще ошибаться в сторону "ключ, возможно, есть".
+* ПАРАЛЛЕЛЬНАЯ ОБРАБОТКА КОМАНД
+Все команды сначала читаются в память. Каждая команда по номеру корзины своего ключа отправляется в один из N шардов;
+шардом владеет ровно один поток со своей HashMap, поэтому блокировки не нужны. Команды одного ключа всегда попадают
+в один шард и выполняются в исходном порядке. Ответы складываются по номеру команды и печатаются в исходном порядке.
 
 --- ДОКАЗАТЕЛЬСТВО КОРРЕКТНОСТИ ---
 1. Для одного и того же ключа будет возвращаться одинаковый номер корзины.
@@ -26,9 +40,12 @@
 обновить значение. Поэтому в худшем случае - О(n)
 * Получение - Если элемент лежит в голове списка - О(1), в худшем случае О(n)
 * Удаление - Если элемент лежит в голове списка - О(1), в худшем случае O(n)
+* Пакетное получение k ключей - k получений, но с перекрытием задержек памяти BATCH_GROUP поисков
+* Проверка фильтра - О(k), где k - число хеш-функций фильтра
 
 --- ПРОСТРАНСТВЕННАЯ СЛОЖНОСТЬ --- 
 Храним элементы, поступающие на вход в односвязных списках - О(n)
+Фильтр занимает counters_per_key байт на каждый ожидаемый ключ - О(n)
 
 */
 
@@ -39,16 +56,112 @@
 #include <forward_list>
 #include <iostream>
 #include <cmath>
+#include <cstdint>
+#include <chrono>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
 
 int P = 16;
 unsigned int MAGIC = 2654435769;
 unsigned int APLHA = std::pow(2, 32);
+// Сколько ключей одновременно "в полёте" при пакетном получении
+const size_t BATCH_GROUP = 16;
+
+// Считающий фильтр Блума. Размер задаётся числом однобайтовых счётчиков на ожидаемый ключ,
+// число хеш-функций подбирается оптимальным для этого размера: k = counters_per_key * ln 2
+class CountingBloomFilter {
+public:
+    CountingBloomFilter(size_t expected_keys, size_t counters_per_key)
+        : counters_(std::max(size_t(1), expected_keys * counters_per_key))
+        , hashes_(std::max(1, static_cast<int>(std::lround(counters_per_key * std::log(2.0)))))
+    {
+    }
+
+    void add(int key) {
+        uint64_t h = mix(key);
+        for (int i = 0; i < hashes_; ++i) {
+            auto& counter = counters_[index(h, i)];
+            if (counter != UINT8_MAX) {
+                ++counter;
+            }
+        }
+        ++keys_;
+    }
+
+    void remove(int key) {
+        uint64_t h = mix(key);
+        for (int i = 0; i < hashes_; ++i) {
+            auto& counter = counters_[index(h, i)];
+            if (counter != UINT8_MAX) {
+                --counter;
+            }
+        }
+        --keys_;
+    }
+
+    bool may_contain(int key) const {
+        uint64_t h = mix(key);
+        for (int i = 0; i < hashes_; ++i) {
+            if (counters_[index(h, i)] == 0) {
+                ++rejected_;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Фильтр пропустил ключ, которого в таблице не оказалось
+    void record_false_positive() const {
+        ++false_positives_;
+    }
+
+    // Доля ложных срабатываний среди всех запросов отсутствующих ключей
+    double false_positive_rate() const {
+        size_t misses = rejected_ + false_positives_;
+        return misses == 0 ? 0.0 : static_cast<double>(false_positives_) / misses;
+    }
+
+    // Теоретическая оценка (1 - e^(-kn/m))^k для текущего числа ключей
+    double expected_false_positive_rate() const {
+        return std::pow(1.0 - std::exp(-static_cast<double>(hashes_) * keys_ / counters_.size()), hashes_);
+    }
+
+    size_t memory_bytes() const {
+        return counters_.size();
+    }
+
+private:
+    static uint64_t mix(int key) {
+        uint64_t x = static_cast<uint32_t>(key) + 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    // Двойное хеширование: i-я функция - h1 + i * h2
+    size_t index(uint64_t h, int i) const {
+        uint64_t h1 = h & 0xFFFFFFFFull;
+        uint64_t h2 = (h >> 32) | 1;
+        return (h1 + i * h2) % counters_.size();
+    }
+
+    std::vector<uint8_t> counters_;
+    int hashes_;
+    size_t keys_ = 0;
+    mutable size_t rejected_ = 0;
+    mutable size_t false_positives_ = 0;
+};
 
 class HashMap {
 public:
 
-    HashMap() {
-        buckets_ = std::pow(2, P);
+    // Корзин 2^bits; номер корзины - старшие bits бит хеша
+    explicit HashMap(int bits = P)
+        : bits_(bits) {
+        buckets_ = std::pow(2, bits_);
         hashmap_.resize(buckets_);
     }
 
@@ -62,58 +175,372 @@ public:
             }
         }
         hashmap_[num_of_bucket].push_front({key, value});
+        if (filter_) {
+            filter_->add(key);
+        }
     }
 
-    int get(int key) {
-        int num_of_bucket = get_bucket(key);
-        auto bucket = hashmap_[num_of_bucket];
-        for (auto& kv_pair: bucket) {
-            if(kv_pair.first == key) {
-                return kv_pair.second;
+    int get(int key) const {
+        if (filter_ && !filter_->may_contain(key)) {
+            return -1;
+        }
+        return find_in_filtered_bucket(hashmap_[get_bucket(key)], key);
+    }
+
+    // Включает фильтр отсутствующих ключей и заносит в него уже лежащие в таблице ключи.
+    // counters_per_key - байт фильтра на ожидаемый ключ: 8 даёт порядка 2% ложных срабатываний, 16 - порядка 0.05%
+    void enable_filter(size_t expected_keys, size_t counters_per_key) {
+        filter_.emplace(expected_keys, counters_per_key);
+        for (const auto& bucket : hashmap_) {
+            for (const auto& kv_pair : bucket) {
+                filter_->add(kv_pair.first);
+            }
+        }
+    }
+
+    const CountingBloomFilter* filter() const {
+        return filter_ ? &*filter_ : nullptr;
+    }
+
+    // Для каждого keys[i] кладёт в out[i] значение или -1, если ключа нет.
+    // Одновременно в полёте BATCH_GROUP поисков, каждый - маленький автомат (AMAC): за один шаг поиск
+    // делает одно обращение к памяти, которую предвыбрал на прошлом шаге, и предвыбирает следующую.
+    // Закончивший поиск сразу уступает место следующему ключу, поэтому длинная цепочка не задерживает группу
+    void GetBatch(const std::vector<int>& keys, std::vector<int>& out) const {
+        out.resize(keys.size());
+        using Iterator = std::forward_list<std::pair<int, int>>::const_iterator;
+        struct Lookup {
+            size_t index;
+            const std::forward_list<std::pair<int, int>>* bucket;
+            // Узел цепочки, который проверяется на следующем шаге; пока in_bucket == false,
+            // корзина только запрошена и узел не выбран
+            Iterator node;
+            bool in_bucket;
+        };
+        Lookup lookups[BATCH_GROUP];
+        size_t next = 0;
+        size_t active = 0;
+        // Берёт следующий ключ, прошедший фильтр, и запрашивает его корзину
+        auto start = [&](Lookup& lookup) {
+            while (next < keys.size()) {
+                size_t index = next++;
+                if (filter_ && !filter_->may_contain(keys[index])) {
+                    out[index] = -1;
+                    continue;
+                }
+                lookup.index = index;
+                lookup.bucket = &hashmap_[get_bucket(keys[index])];
+                lookup.in_bucket = false;
+                __builtin_prefetch(lookup.bucket);
+                return true;
+            }
+            return false;
+        };
+        for (; active < BATCH_GROUP && start(lookups[active]); ++active) {
+        }
+        while (active > 0) {
+            for (size_t i = 0; i < active;) {
+                Lookup& lookup = lookups[i];
+                int key = keys[lookup.index];
+                bool done = false;
+                if (!lookup.in_bucket) {
+                    lookup.node = lookup.bucket->begin();
+                    lookup.in_bucket = true;
+                } else if (lookup.node->first == key) {
+                    out[lookup.index] = lookup.node->second;
+                    done = true;
+                } else {
+                    ++lookup.node;
+                }
+                if (!done && lookup.node == lookup.bucket->end()) {
+                    out[lookup.index] = -1;
+                    if (filter_) {
+                        filter_->record_false_positive();
+                    }
+                    done = true;
+                }
+                if (!done) {
+                    __builtin_prefetch(&*lookup.node);
+                    ++i;
+                } else if (start(lookup)) {
+                    // Корзина нового ключа только запрошена: её черёд на следующем круге
+                    ++i;
+                } else {
+                    lookup = lookups[--active];
+                }
             }
         }
-        return -1;
     }
 
     void remove(int key) {
+        auto removed = erase(key);
+        if (removed) {
+            std::cout << *removed << std::endl;
+        } else {
+            std::cout << "None" << std::endl;
+        }
+    }
+
+    // Удаляет ключ и возвращает его значение, либо пустой optional, если ключа не было
+    std::optional<int> erase(int key) {
+        if (filter_ && !filter_->may_contain(key)) {
+            return std::nullopt;
+        }
         int num_of_bucket = get_bucket(key);
         auto& bucket = hashmap_[num_of_bucket];
         auto prev = bucket.before_begin();
         for (auto it = bucket.begin(); it != bucket.end(); ++it) {
             if((*it).first == key) {
-                std::cout << (*it).second << std::endl;
+                int value = (*it).second;
                 bucket.erase_after(prev);
-                return;
+                if (filter_) {
+                    filter_->remove(key);
+                }
+                return value;
             }
             prev = it;
         }
-    	std::cout << "None" << std::endl;
-        
+        if (filter_) {
+            filter_->record_false_positive();
+        }
+        return std::nullopt;
     }
 
-    int get_bucket(int key) {
-        int bucket = (get_hash(key) * MAGIC % APLHA) >> (32 - P);
+    int get_bucket(int key) const {
+        int bucket = (get_hash(key) * MAGIC % APLHA) >> (32 - bits_);
         return bucket;
     }
 
     // Не будем выкидывать хеширование, а введём специальную тождественную хеш-функцию, 
     // Которая будет возвращать свой аргумент неизменным: hash(k)=k
 
-    int get_hash(int key) {
+    int get_hash(int key) const {
         return key;
     }
 
 
 private:
+    static int find_in_bucket(const std::forward_list<std::pair<int, int>>& bucket, int key) {
+        for (auto& kv_pair: bucket) {
+            if(kv_pair.first == key) {
+                return kv_pair.second;
+            }
+        }
+        return -1;
+    }
+
+    // Поиск в корзине ключа, который уже прошёл фильтр: промах здесь - ложное срабатывание фильтра
+    int find_in_filtered_bucket(const std::forward_list<std::pair<int, int>>& bucket, int key) const {
+        int result = find_in_bucket(bucket, key);
+        if (result == -1 && filter_) {
+            filter_->record_false_positive();
+        }
+        return result;
+    }
+
     std::vector<std::forward_list<std::pair<int, int>>> hashmap_;
+    int bits_;
     int buckets_;
+    std::optional<CountingBloomFilter> filter_;
+};
+
+// Сравнение GetBatch с циклом из одиночных get на таблице, которая заметно больше кэша последнего уровня.
+// Каждый вариант прогоняется несколько раз, порядок вариантов чередуется, и берётся лучшее время:
+// так ни один вариант не получает выгоды от кэша и предсказателя, прогретых другим.
+// Запуск: ./hashmap bench [число ключей]
+void run_benchmark(int keys_count) {
+    const int rounds = 5;
+    P = 22;
+    HashMap hashmap;
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist(0, 1000000000);
+    for (int i = 0; i < keys_count; ++i) {
+        hashmap.put(dist(gen), i);
+    }
+
+    std::vector<int> keys(keys_count);
+    for (auto& key : keys) {
+        key = dist(gen);
+    }
+    std::vector<int> single(keys.size());
+    std::vector<int> batch;
+
+    auto run_single = [&] {
+        for (size_t i = 0; i < keys.size(); ++i) {
+            single[i] = hashmap.get(keys[i]);
+        }
+    };
+    auto run_batch = [&] {
+        hashmap.GetBatch(keys, batch);
+    };
+    auto as_ms = [](auto duration) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
+    };
+    auto time_ms = [&](auto run) {
+        auto start = std::chrono::steady_clock::now();
+        run();
+        return as_ms(std::chrono::steady_clock::now() - start);
+    };
+    long long best_single = -1;
+    long long best_batch = -1;
+    for (int round = 0; round < rounds; ++round) {
+        long long single_ms;
+        long long batch_ms;
+        if (round % 2 == 0) {
+            single_ms = time_ms(run_single);
+            batch_ms = time_ms(run_batch);
+        } else {
+            batch_ms = time_ms(run_batch);
+            single_ms = time_ms(run_single);
+        }
+        best_single = best_single == -1 ? single_ms : std::min(best_single, single_ms);
+        best_batch = best_batch == -1 ? batch_ms : std::min(best_batch, batch_ms);
+    }
+
+    std::cout << "get x " << keys.size() << ": " << best_single << " ms (best of " << rounds << ")" << std::endl;
+    std::cout << "GetBatch: " << best_batch << " ms (best of " << rounds << ")" << std::endl;
+    std::cout << (single == batch ? "results match" : "RESULTS DIFFER") << std::endl;
+}
+
+struct Command {
+    enum class Type { GET, PUT, DELETE };
+    Type type;
+    int key;
+    int value;
 };
 
-int main() {
+// Выполняет команды на threads_count шардах, у каждого шарда своя HashMap и свой поток.
+// Шард выбирается по младшим битам номера корзины полной таблицы, а корзина внутри шарда - по старшим,
+// поэтому таблица шарда в threads_count раз меньше (с округлением до степени двойки вверх),
+// и вместе шарды занимают столько же памяти, сколько одна таблица.
+// Возвращает ответы в порядке команд; у put ответа нет, у get/delete пустой optional означает "None"
+std::vector<std::optional<int>> process_sharded(const std::vector<Command>& commands, size_t threads_count) {
+    int shard_bits = P;
+    while (shard_bits > 1 && (size_t(1) << (P - shard_bits + 1)) <= threads_count) {
+        --shard_bits;
+    }
+    HashMap router(P);
+    std::vector<HashMap> shards;
+    shards.reserve(threads_count);
+    for (size_t shard = 0; shard < threads_count; ++shard) {
+        shards.emplace_back(shard_bits);
+    }
+    std::vector<std::vector<size_t>> shard_commands(threads_count);
+    for (size_t i = 0; i < commands.size(); ++i) {
+        shard_commands[router.get_bucket(commands[i].key) % threads_count].push_back(i);
+    }
+
+    std::vector<std::optional<int>> answers(commands.size());
+    auto worker = [&](size_t shard) {
+        HashMap& hashmap = shards[shard];
+        for (size_t i : shard_commands[shard]) {
+            const Command& command = commands[i];
+            if (command.type == Command::Type::GET) {
+                int result = hashmap.get(command.key);
+                if (result != -1) {
+                    answers[i] = result;
+                }
+            } else if (command.type == Command::Type::PUT) {
+                hashmap.put(command.key, command.value);
+            } else {
+                answers[i] = hashmap.erase(command.key);
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t shard = 1; shard < threads_count; ++shard) {
+        threads.emplace_back(worker, shard);
+    }
+    worker(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return answers;
+}
+
+// ./hashmap parallel [число потоков] - параллельная обработка команд, по умолчанию по числу ядер.
+// Время обработки без чтения и вывода пишется в stderr
+void run_parallel(size_t threads_count) {
+    std::ios::sync_with_stdio(false);
+    std::cin.tie(nullptr);
+    int requests;
+    std::cin >> requests;
+    std::vector<Command> commands;
+    commands.reserve(requests);
+    for (int i = 0; i < requests; ++i) {
+        std::string operation;
+        Command command{Command::Type::GET, 0, 0};
+        std::cin >> operation >> command.key;
+        if (operation == "put") {
+            command.type = Command::Type::PUT;
+            std::cin >> command.value;
+        } else if (operation == "delete") {
+            command.type = Command::Type::DELETE;
+        }
+        commands.push_back(command);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto answers = process_sharded(commands, threads_count);
+    auto duration = std::chrono::steady_clock::now() - start;
+    std::cerr << threads_count << " threads: " << commands.size() << " commands in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(duration).count() << " ms" << std::endl;
+    for (size_t i = 0; i < commands.size(); ++i) {
+        if (commands[i].type == Command::Type::PUT) {
+            continue;
+        }
+        if (answers[i]) {
+            std::cout << *answers[i] << '\n';
+        } else {
+            std::cout << "None\n";
+        }
+    }
+    std::cout.flush();
+}
+
+// Число потоков из командной строки: целое больше нуля без лишних символов, иначе пустой optional
+std::optional<size_t> parse_threads_count(const std::string& text) {
+    try {
+        size_t parsed = 0;
+        long long value = std::stoll(text, &parsed);
+        if (parsed != text.size() || value <= 0) {
+            return std::nullopt;
+        }
+        return static_cast<size_t>(value);
+    } catch (const std::logic_error&) {
+        return std::nullopt;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::string(argv[1]) == "bench") {
+        run_benchmark(argc > 2 ? std::stoi(argv[2]) : 8000000);
+        return 0;
+    }
+    if (argc > 1 && std::string(argv[1]) == "parallel") {
+        size_t threads_count = std::max(1u, std::thread::hardware_concurrency());
+        if (argc > 2) {
+            auto parsed = parse_threads_count(argv[2]);
+            if (!parsed) {
+                std::cerr << "thread count must be a positive integer: " << argv[2] << std::endl;
+                return 1;
+            }
+            threads_count = *parsed;
+        }
+        run_parallel(threads_count);
+        return 0;
+    }
+
     HashMap hashmap;
     int requests;
 
     std::cin >> requests;
+    // ./hashmap filter [байт на ключ] - с фильтром отсутствующих ключей, статистика фильтра пишется в stderr
+    bool with_filter = argc > 1 && std::string(argv[1]) == "filter";
+    if (with_filter) {
+        hashmap.enable_filter(requests, argc > 2 ? std::stoi(argv[2]) : 8);
+    }
     for (int i = 0; i < requests; ++i) {
         std::string operation;
         std::cin >> operation;
@@ -135,4 +562,10 @@ int main() {
             hashmap.remove(value);
         }
     }
+    if (with_filter) {
+        const auto* filter = hashmap.filter();
+        std::cerr << "filter: " << filter->memory_bytes() << " bytes, false positive rate "
+                  << filter->false_positive_rate() << " (expected " << filter->expected_false_positive_rate() << ")"
+                  << std::endl;
+    }
 }
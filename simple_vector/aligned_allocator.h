@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include "simple_vector.h"
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+constexpr size_t CACHE_LINE_SIZE = 64;
+constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+enum class HugePageMode {
+    // Обычная память из кучи
+    NONE,
+    // mmap, выровненный по 2 МиБ, и madvise(MADV_HUGEPAGE): ядро подставит прозрачные большие страницы
+    TRANSPARENT,
+    // mmap с MAP_HUGETLB из заранее выделенного пула; если пул пуст - как TRANSPARENT
+    EXPLICIT,
+};
+
+// Аллокатор, выдающий память, выровненную по Alignment байт (например, по строке кэша или под AVX-512).
+// Выделения от Threshold байт и больше в режимах TRANSPARENT и EXPLICIT берутся через mmap на больших страницах.
+// Путь выбирается по размеру, поэтому deallocate с тем же n всегда освобождает память тем же способом
+template <typename Type, size_t Alignment = CACHE_LINE_SIZE, HugePageMode Mode = HugePageMode::NONE,
+          size_t Threshold = HUGE_PAGE_SIZE>
+class AlignedAllocator {
+    static_assert(Alignment >= alignof(Type), "Alignment is weaker than the type requires");
+    static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+    static_assert(Alignment <= HUGE_PAGE_SIZE, "Alignment above the huge page size is not supported");
+
+public:
+    using value_type = Type;
+
+    template <typename Other>
+    struct rebind {
+        using other = AlignedAllocator<Other, Alignment, Mode, Threshold>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template <typename Other>
+    AlignedAllocator(const AlignedAllocator<Other, Alignment, Mode, Threshold>&) noexcept {
+    }
+
+    Type* allocate(size_t n) {
+        size_t bytes = n * sizeof(Type);
+        if (UsesHugePages(bytes)) {
+            return static_cast<Type*>(MapHugePages(bytes));
+        }
+        return static_cast<Type*>(operator new(bytes, std::align_val_t(Alignment)));
+    }
+
+    void deallocate(Type* ptr, size_t n) noexcept {
+        size_t bytes = n * sizeof(Type);
+        if (UsesHugePages(bytes)) {
+            UnmapHugePages(ptr, bytes);
+            return;
+        }
+        operator delete(ptr, std::align_val_t(Alignment));
+    }
+
+private:
+    static bool UsesHugePages(size_t bytes) noexcept {
+#ifdef __linux__
+        return Mode != HugePageMode::NONE && bytes >= Threshold;
+#else
+        return false;
+#endif
+    }
+
+    static size_t RoundToHugePages(size_t bytes) noexcept {
+        return (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+    }
+
+#ifdef __linux__
+    static void* MapHugePages(size_t bytes) {
+        size_t length = RoundToHugePages(bytes);
+        if constexpr (Mode == HugePageMode::EXPLICIT) {
+            void* ptr = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (ptr != MAP_FAILED) {
+                return ptr;
+            }
+        }
+        // Берём на одну большую страницу больше и отрезаем края, чтобы начало было выровнено по 2 МиБ
+        size_t mapped_length = length + HUGE_PAGE_SIZE;
+        void* mapped = mmap(nullptr, mapped_length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mapped == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        uintptr_t begin = reinterpret_cast<uintptr_t>(mapped);
+        uintptr_t aligned = (begin + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+        if (aligned != begin) {
+            munmap(mapped, aligned - begin);
+        }
+        size_t tail = begin + mapped_length - (aligned + length);
+        if (tail != 0) {
+            munmap(reinterpret_cast<void*>(aligned + length), tail);
+        }
+        madvise(reinterpret_cast<void*>(aligned), length, MADV_HUGEPAGE);
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    static void UnmapHugePages(void* ptr, size_t bytes) noexcept {
+        munmap(ptr, RoundToHugePages(bytes));
+    }
+#else
+    static void* MapHugePages(size_t) {
+        throw std::bad_alloc();
+    }
+
+    static void UnmapHugePages(void*, size_t) noexcept {
+    }
+#endif
+};
+
+template <typename Lhs, typename Rhs, size_t Alignment, HugePageMode Mode, size_t Threshold>
+bool operator==(const AlignedAllocator<Lhs, Alignment, Mode, Threshold>&,
+                const AlignedAllocator<Rhs, Alignment, Mode, Threshold>&) noexcept {
+    return true;
+}
+
+template <typename Lhs, typename Rhs, size_t Alignment, HugePageMode Mode, size_t Threshold>
+bool operator!=(const AlignedAllocator<Lhs, Alignment, Mode, Threshold>&,
+                const AlignedAllocator<Rhs, Alignment, Mode, Threshold>&) noexcept {
+    return false;
+}
+
+// Вектор с выровненным буфером, например, под выровненные SIMD-загрузки
+template <typename Type, size_t Alignment = CACHE_LINE_SIZE>
+using AlignedVector = SimpleVector<Type, AlignedAllocator<Type, Alignment>>;
+
+// Вектор, крупные буферы которого лежат на больших страницах
+template <typename Type, size_t Alignment = CACHE_LINE_SIZE, HugePageMode Mode = HugePageMode::TRANSPARENT>
+using HugePageVector = SimpleVector<Type, AlignedAllocator<Type, Alignment, Mode>>;
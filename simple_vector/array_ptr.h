@@ -1,37 +1,58 @@
+#pragma once
+
 #include <cassert>
 #include <cstdlib>
+#include <memory>
+#include <new>
 #include <utility>
+#include "instrumentation.h"
 
-template <typename Type>
+// Владеет сырой памятью под массив элементов типа Type, полученной от аллокатора Allocator.
+// Элементы в этой памяти не создаются и не разрушаются - этим занимается владелец ArrayPtr
+template <typename Type, typename Allocator = std::allocator<Type>>
 class ArrayPtr {
+    using AllocatorTraits = std::allocator_traits<Allocator>;
+
 public:
     // Инициализирует ArrayPtr нулевым указателем
     ArrayPtr() = default;
+
+    explicit ArrayPtr(const Allocator& alloc) noexcept
+        : alloc_(alloc) {
+    }
     
-    ArrayPtr(ArrayPtr&& move_ptr) {
-        raw_ptr_ = std::move(move_ptr);
+    // Аллокатор переезжает вместе с памятью, которую он выделил
+    ArrayPtr(ArrayPtr&& move_ptr) noexcept
+        : alloc_(move_ptr.alloc_) {
+        raw_ptr_ = std::exchange(move_ptr.raw_ptr_, nullptr);
+        size_ = std::exchange(move_ptr.size_, 0);
     }
     
-    ArrayPtr& operator=(ArrayPtr&& move_ptr) {
+    ArrayPtr& operator=(ArrayPtr&& move_ptr) noexcept {
         swap(move_ptr);
         return *this;
     }
 
     
-    // Создаёт в куче массив из size элементов типа Type.
+    // Выделяет неинициализированную память под size элементов типа Type.
     // Если size == 0, поле raw_ptr_ должно быть равно nullptr
-    explicit ArrayPtr(size_t size) {
+    explicit ArrayPtr(size_t size, const Allocator& alloc = Allocator())
+        : alloc_(alloc) {
         if (size==0) {
             raw_ptr_ = nullptr;
         } else {
-            raw_ptr_ = new Type[size]{};
+            raw_ptr_ = AllocatorTraits::allocate(alloc_, size);
+            size_ = size;
+            instrumentation::RecordAllocation(size * sizeof(Type));
         }
     }
 
-    // Конструктор из сырого указателя, хранящего адрес массива в куче либо nullptr
-    explicit ArrayPtr(Type* raw_ptr) noexcept {
+    // Конструктор из сырого указателя на память под size элементов, выделенную аллокатором alloc, либо nullptr
+    ArrayPtr(Type* raw_ptr, size_t size, const Allocator& alloc = Allocator()) noexcept
+        : alloc_(alloc) {
         if(raw_ptr) {
             raw_ptr_ = raw_ptr;
+            size_ = size;
         } else {
             raw_ptr_ = nullptr;
         }
@@ -41,7 +62,9 @@ public:
     ArrayPtr(const ArrayPtr&) = delete;
 
     ~ArrayPtr() {
-        delete [] raw_ptr_;
+        if (raw_ptr_) {
+            AllocatorTraits::deallocate(alloc_, raw_ptr_, size_);
+        }
         raw_ptr_ = nullptr;
     }
 
@@ -51,7 +74,8 @@ public:
     // Прекращает владением массивом в памяти, возвращает значение адреса массива
     // После вызова метода указатель на массив должен обнулиться
     [[nodiscard]] Type* Release() noexcept {
-        return exchange(raw_ptr_, nullptr);
+        size_ = 0;
+        return std::exchange(raw_ptr_, nullptr);
     }
 
     // Возвращает ссылку на элемент массива с индексом index
@@ -71,15 +95,28 @@ public:
 
     // Возвращает значение сырого указателя, хранящего адрес начала массива
     Type* Get() const noexcept {
-        // Заглушка. Реализуйте метод самостоятельно
         return raw_ptr_;
     }
 
-    // Обменивается значениям указателя на массив с объектом other
+    const Allocator& GetAllocator() const noexcept {
+        return alloc_;
+    }
+
+    // Обменивается значениям указателя на массив с объектом other.
+    // Аллокаторы меняются местами, только если они это допускают (propagate_on_container_swap),
+    // иначе вызывающий должен гарантировать, что аллокаторы равны
     void swap(ArrayPtr& other) noexcept {
         std::swap(raw_ptr_, other.raw_ptr_);
+        std::swap(size_, other.size_);
+        if constexpr (AllocatorTraits::propagate_on_container_swap::value) {
+            std::swap(alloc_, other.alloc_);
+        } else {
+            assert(alloc_ == other.alloc_);
+        }
     }
 
 private:
+    Allocator alloc_;
     Type* raw_ptr_ = nullptr;
+    size_t size_ = 0;
 };
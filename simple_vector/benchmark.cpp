@@ -0,0 +1,493 @@
+#include "simple_vector.h"
+#include "small_vector.h"
+#include "memory_resources.h"
+#include "simd_algorithms.h"
+#include "mmap_vector.h"
+#include "soa_vector.h"
+#include "cow_vector.h"
+#include "segmented_vector.h"
+#include "concurrent_vector.h"
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <malloc.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace std;
+
+// Печатает время жизни объекта в миллисекундах
+class LogDuration {
+public:
+    explicit LogDuration(string id)
+        : id_(move(id)) {
+    }
+    ~LogDuration() {
+        const auto duration = chrono::steady_clock::now() - start_;
+        cerr << id_ << ": " << chrono::duration_cast<chrono::milliseconds>(duration).count() << " ms" << endl;
+    }
+
+private:
+    const string id_;
+    const chrono::steady_clock::time_point start_ = chrono::steady_clock::now();
+};
+
+struct PodRecord {
+    int id;
+    double price;
+    char tag[16];
+};
+
+// Одинаковые владельцы памяти; второй помечен как побайтово переносимый
+struct Handle {
+    Handle() : ptr(make_unique<int>(0)) {
+    }
+    unique_ptr<int> ptr;
+};
+
+struct RelocatableHandle {
+    RelocatableHandle() : ptr(make_unique<int>(0)) {
+    }
+    unique_ptr<int> ptr;
+};
+
+template <>
+struct IsTriviallyRelocatable<RelocatableHandle> : true_type {
+};
+
+template <typename Container, typename Value>
+size_t PushMany(size_t count, const Value& value) {
+    Container container;
+    for (size_t i = 0; i < count; ++i) {
+        container.push_back(value);
+    }
+    return container.size();
+}
+
+// Рост push-нагрузкой: std::string переносится перемещением, PodRecord - одним memcpy
+void BenchmarkPushBack() {
+    const size_t count = 5'000'000;
+    const string text = "a string that does not fit into SSO"s;
+    const PodRecord record{1, 2.5, "tag"};
+    size_t total = 0;
+    {
+        LogDuration guard("SimpleVector<string> PushBack x "s + to_string(count));
+        SimpleVector<string> v;
+        for (size_t i = 0; i < count; ++i) {
+            v.PushBack(text);
+        }
+        total += v.GetSize();
+    }
+    {
+        LogDuration guard("vector<string> push_back x "s + to_string(count));
+        total += PushMany<vector<string>>(count, text);
+    }
+    {
+        LogDuration guard("SimpleVector<PodRecord> PushBack x "s + to_string(count));
+        SimpleVector<PodRecord> v;
+        for (size_t i = 0; i < count; ++i) {
+            v.PushBack(record);
+        }
+        total += v.GetSize();
+    }
+    {
+        LogDuration guard("vector<PodRecord> push_back x "s + to_string(count));
+        total += PushMany<vector<PodRecord>>(count, record);
+    }
+    {
+        LogDuration guard("SimpleVector<Handle> EmplaceBack x "s + to_string(count));
+        SimpleVector<Handle> v;
+        for (size_t i = 0; i < count; ++i) {
+            v.EmplaceBack();
+        }
+        total += v.GetSize();
+    }
+    {
+        LogDuration guard("SimpleVector<RelocatableHandle> EmplaceBack x "s + to_string(count));
+        SimpleVector<RelocatableHandle> v;
+        for (size_t i = 0; i < count; ++i) {
+            v.EmplaceBack();
+        }
+        total += v.GetSize();
+    }
+    cout << total << endl;
+}
+
+// Много короткоживущих векторов из нескольких элементов
+template <typename Vector>
+size_t FillShortLived(size_t rounds, size_t elements) {
+    size_t total = 0;
+    for (size_t round = 0; round < rounds; ++round) {
+        Vector v;
+        for (size_t i = 0; i < elements; ++i) {
+            v.PushBack(static_cast<int>(round + i));
+        }
+        total += v[elements - 1];
+    }
+    return total;
+}
+
+void BenchmarkSmallVector() {
+    const size_t rounds = 10'000'000;
+    const size_t elements = 6;
+    size_t total = 0;
+    {
+        LogDuration guard("SimpleVector<int> x "s + to_string(rounds) + " short-lived"s);
+        total += FillShortLived<SimpleVector<int>>(rounds, elements);
+    }
+    {
+        LogDuration guard("SmallVector<int, 8> x "s + to_string(rounds) + " short-lived"s);
+        total += FillShortLived<SmallVector<int, 8>>(rounds, elements);
+    }
+    cout << total << endl;
+}
+
+// Обработка запроса: несколько векторов, которые живут до конца запроса
+template <typename Vector, typename... AllocatorArgs>
+size_t HandleRequest(size_t vectors, size_t elements, AllocatorArgs... alloc) {
+    SimpleVector<Vector> request_vectors;
+    request_vectors.Reserve(vectors);
+    size_t total = 0;
+    for (size_t i = 0; i < vectors; ++i) {
+        Vector& v = request_vectors.EmplaceBack(alloc...);
+        for (size_t j = 0; j < elements; ++j) {
+            v.PushBack(static_cast<int>(i + j));
+        }
+        total += v[elements - 1];
+    }
+    return total;
+}
+
+void BenchmarkMemoryResources() {
+    const size_t requests = 200'000;
+    const size_t vectors = 16;
+    const size_t elements = 40;
+    size_t total = 0;
+    {
+        LogDuration guard("global heap x "s + to_string(requests) + " requests"s);
+        for (size_t r = 0; r < requests; ++r) {
+            total += HandleRequest<SimpleVector<int>>(vectors, elements);
+        }
+    }
+    {
+        LogDuration guard("MonotonicArena x "s + to_string(requests) + " requests"s);
+        MonotonicArena arena;
+        for (size_t r = 0; r < requests; ++r) {
+            total += HandleRequest<PmrSimpleVector<int>>(vectors, elements, &arena);
+            arena.Release();
+        }
+    }
+    {
+        LogDuration guard("SizeClassPool x "s + to_string(requests) + " requests"s);
+        SizeClassPool pool;
+        for (size_t r = 0; r < requests; ++r) {
+            total += HandleRequest<PmrSimpleVector<int>>(vectors, elements, &pool);
+        }
+    }
+    cout << total << endl;
+}
+
+// Плоские циклы для сравнения с векторизованными ядрами
+template <typename Type>
+Type PlainSum(const SimpleVector<Type>& v) {
+    Type result{};
+    for (Type x : v) {
+        result += x;
+    }
+    return result;
+}
+
+template <typename Type>
+Type PlainDot(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+    Type result{};
+    for (size_t i = 0; i < lhs.GetSize(); ++i) {
+        result += lhs[i] * rhs[i];
+    }
+    return result;
+}
+
+template <typename Type>
+size_t PlainCount(const SimpleVector<Type>& v, Type value) {
+    size_t result = 0;
+    for (Type x : v) {
+        result += x == value;
+    }
+    return result;
+}
+
+template <typename Type>
+bool PlainEqual(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename Type>
+void BenchmarkSimdFor(const string& type_name) {
+    const size_t size = 4'000'000;
+    const int repeats = 50;
+    SimpleVector<Type> v(size);
+    SimpleVector<Type> w(size);
+    for (size_t i = 0; i < size; ++i) {
+        v[i] = static_cast<Type>(i % 100);
+        w[i] = static_cast<Type>(i % 7);
+    }
+    auto copy = v;
+    double total = 0;
+    auto run = [&](const string& name, auto func) {
+        LogDuration guard(type_name + " "s + name + " x "s + to_string(repeats));
+        for (int r = 0; r < repeats; ++r) {
+            total += static_cast<double>(func());
+        }
+    };
+    run("plain sum"s, [&] { return PlainSum(v); });
+    run("Sum"s, [&] { return Sum(v); });
+    run("plain dot"s, [&] { return PlainDot(v, w); });
+    run("Dot"s, [&] { return Dot(v, w); });
+    run("plain count"s, [&] { return PlainCount(v, Type(42)); });
+    run("Count"s, [&] { return Count(v, Type(42)); });
+    run("std::equal"s, [&] { return PlainEqual(v, copy); });
+    run("operator=="s, [&] { return v == copy; });
+    cout << total << endl;
+}
+
+void BenchmarkSimd() {
+    BenchmarkSimdFor<float>("float"s);
+    BenchmarkSimdFor<int>("int"s);
+    BenchmarkSimdFor<double>("double"s);
+}
+
+// Старт с готового файла: чтение целиком в SimpleVector против отображения
+void BenchmarkMmapVector() {
+    const size_t records = 16'000'000;
+    const string path = (filesystem::temp_directory_path() / "simple_vector_mmap_bench.bin").string();
+    remove(path.c_str());
+    {
+        MmapVector<PodRecord> file(path);
+        file.Resize(records);
+        for (size_t i = 0; i < records; ++i) {
+            file[i].id = static_cast<int>(i);
+        }
+    }
+    long long total = 0;
+    {
+        LogDuration guard("read "s + to_string(records) + " records into SimpleVector"s);
+        ifstream input(path, ios::binary);
+        SimpleVector<PodRecord> loaded(records);
+        input.read(reinterpret_cast<char*>(loaded.begin()), records * sizeof(PodRecord));
+        total += loaded[records / 2].id;
+    }
+    {
+        LogDuration guard("open "s + to_string(records) + " records as MmapVector"s);
+        MmapVector<PodRecord> mapped(path, MapMode::READ_ONLY);
+        total += mapped[records / 2].id;
+    }
+    {
+        LogDuration guard("open MmapVector and scan every record"s);
+        MmapVector<PodRecord> mapped(path, MapMode::READ_ONLY);
+        for (const PodRecord& record : mapped) {
+            total += record.id;
+        }
+    }
+    remove(path.c_str());
+    cout << total << endl;
+}
+
+// Глубокая копия, заполнение и рост огромного вектора: последовательно и в пуле потоков
+void BenchmarkParallelConstruct() {
+    const size_t size = 50'000'000;
+    const size_t saved_threshold = ParallelThresholdBytes().load();
+    long long total = 0;
+    for (bool parallel : {false, true}) {
+        SetParallelThreshold(parallel ? saved_threshold : 0);
+        const string mode = parallel ? " parallel, "s + to_string(GetParallelPool().GetThreadCount()) + " threads"s
+                                     : " serial"s;
+        SimpleVector<int> filled;
+        {
+            LogDuration guard("fill "s + to_string(size) + " ints"s + mode);
+            filled = SimpleVector<int>(size, 1);
+        }
+        {
+            LogDuration guard("copy "s + to_string(size) + " ints"s + mode);
+            SimpleVector<int> copy(filled);
+            total += copy[size - 1];
+        }
+        {
+            LogDuration guard("grow "s + to_string(size) + " ints"s + mode);
+            filled.Reserve(2 * size);
+            total += filled[size / 2];
+        }
+    }
+    SetParallelThreshold(saved_threshold);
+    cout << total << endl;
+}
+
+// Сумма одного поля: массив структур против структуры массивов
+void BenchmarkSoaVector() {
+    const size_t size = 4'000'000;
+    const int passes = 20;
+    SimpleVector<PodRecord> records(ReserveProxyObj{size});
+    SoaVector<int, double, array<char, 16>> columns(ReserveProxyObj{size});
+    for (size_t i = 0; i < size; ++i) {
+        records.PushBack({static_cast<int>(i), i * 0.5, {}});
+        columns.PushBack(static_cast<int>(i), i * 0.5, array<char, 16>{});
+    }
+    double total = 0;
+    {
+        LogDuration guard("SimpleVector<PodRecord> price scan x "s + to_string(passes));
+        for (int pass = 0; pass < passes; ++pass) {
+            for (const PodRecord& record : records) {
+                total += record.price;
+            }
+        }
+    }
+    {
+        LogDuration guard("SoaVector price column scan x "s + to_string(passes));
+        for (int pass = 0; pass < passes; ++pass) {
+            for (double price : columns.Column<1>()) {
+                total += price;
+            }
+        }
+    }
+    cout << total << endl;
+}
+
+// Раздача одного буфера многим читателям: глубокие копии против общего буфера
+void BenchmarkCowVector() {
+    const size_t size = 4'000'000;
+    const size_t consumers = 16;
+    long long total = 0;
+    SimpleVector<int> source(size, 1);
+    {
+        LogDuration guard("SimpleVector copies to "s + to_string(consumers) + " consumers"s);
+        vector<SimpleVector<int>> copies(consumers, source);
+        for (const auto& copy : copies) {
+            total += copy[size / 2];
+        }
+    }
+    CowVector<int> shared(move(source));
+    {
+        LogDuration guard("CowVector copies to "s + to_string(consumers) + " consumers"s);
+        vector<CowVector<int>> copies(consumers, shared);
+        for (const auto& copy : copies) {
+            total += copy[size / 2];
+        }
+    }
+    cout << total << endl;
+}
+
+// Объём резидентной памяти процесса в КиБ: текущий (VmRSS) или пиковый (VmHWM)
+size_t ReadRssKb(const string& field) {
+    ifstream status("/proc/self/status");
+    string line;
+    while (getline(status, line)) {
+        if (line.rfind(field, 0) == 0) {
+            return stoul(line.substr(field.size()));
+        }
+    }
+    return 0;
+}
+
+// Каждый вариант запускается в отдельном процессе, иначе пик памяти первого скрыл бы пик второго
+template <typename Vector>
+void BenchmarkGrowth(const string& name, size_t size) {
+    cerr.flush();
+    cout.flush();
+    pid_t child = fork();
+    if (child != 0) {
+        waitpid(child, nullptr, 0);
+        return;
+    }
+    // Свободная память, оставшаяся в куче от прошлых замеров, иначе досталась бы этому без роста RSS
+    malloc_trim(0);
+    size_t before = ReadRssKb("VmRSS:"s);
+    chrono::nanoseconds worst{0};
+    {
+        LogDuration guard(name + " push back "s + to_string(size) + " ints"s);
+        Vector v;
+        for (size_t i = 0; i < size; ++i) {
+            auto start = chrono::steady_clock::now();
+            v.PushBack(static_cast<int>(i));
+            worst = max(worst, chrono::steady_clock::now() - start);
+        }
+        cout << v[size / 2] << endl;
+    }
+    cerr << name << " worst push back: " << chrono::duration_cast<chrono::microseconds>(worst).count()
+         << " us, peak RSS growth: " << (ReadRssKb("VmHWM:"s) - before) / 1024 << " MiB" << endl;
+    _exit(0);
+}
+
+// Рост огромного вектора: худшая задержка одного PushBack и пик памяти
+void BenchmarkSegmentedVector() {
+    const size_t size = 50'000'000;
+    BenchmarkGrowth<SimpleVector<int>>("SimpleVector"s, size);
+    BenchmarkGrowth<SegmentedVector<int>>("SegmentedVector"s, size);
+}
+
+// Добавления из нескольких потоков: ConcurrentVector против SimpleVector под мьютексом.
+// Масштабирование видно, только пока потоков не больше, чем аппаратных потоков: иначе потоки
+// выполняются по очереди, и сравнивается лишь цена одного добавления
+void BenchmarkConcurrentVector() {
+    const size_t total = 8'000'000;
+    const unsigned hardware_threads = thread::hardware_concurrency();
+    cerr << "hardware threads: "s << hardware_threads << endl;
+    for (size_t threads : {1, 2, 4, 8}) {
+        const size_t per_thread = total / threads;
+        if (threads > hardware_threads) {
+            cerr << "threads "s << threads << " > hardware threads: no real contention, per-append cost only"s << endl;
+        }
+        {
+            SimpleVector<int> shared;
+            mutex guard_mutex;
+            LogDuration guard("mutex SimpleVector, "s + to_string(threads) + " threads"s);
+            vector<thread> producers;
+            for (size_t t = 0; t < threads; ++t) {
+                producers.emplace_back([&] {
+                    for (size_t i = 0; i < per_thread; ++i) {
+                        lock_guard lock(guard_mutex);
+                        shared.PushBack(static_cast<int>(i));
+                    }
+                });
+            }
+            for (thread& producer : producers) {
+                producer.join();
+            }
+        }
+        {
+            ConcurrentVector<int> shared;
+            LogDuration guard("ConcurrentVector, "s + to_string(threads) + " threads"s);
+            vector<thread> producers;
+            for (size_t t = 0; t < threads; ++t) {
+                producers.emplace_back([&] {
+                    for (size_t i = 0; i < per_thread; ++i) {
+                        shared.PushBack(static_cast<int>(i));
+                    }
+                });
+            }
+            for (thread& producer : producers) {
+                producer.join();
+            }
+        }
+    }
+}
+
+int main() {
+    BenchmarkPushBack();
+    BenchmarkSmallVector();
+    BenchmarkMemoryResources();
+    BenchmarkSimd();
+    BenchmarkMmapVector();
+    BenchmarkParallelConstruct();
+    BenchmarkSoaVector();
+    BenchmarkCowVector();
+    BenchmarkSegmentedVector();
+    BenchmarkConcurrentVector();
+}
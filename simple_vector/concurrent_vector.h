@@ -0,0 +1,238 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Вектор только для добавления, в который одновременно пишут несколько потоков без блокировок.
+// Поток получает номер слота атомарным fetch_add и создаёт элемент в нём независимо от остальных.
+// Память выделяется кусками, размер k-го куска - 2^(FirstChunkShift + k) элементов: куски никогда
+// не переезжают, и номер слота переводится в кусок и смещение через старший бит.
+// Читатели видят опубликованный префикс [0, GetSize()): элементы в нём созданы полностью и больше
+// не меняются. Слоты, которые заполнены раньше предыдущих, публикуются, когда догонят предыдущие:
+// границу сдвигает поток, заполнивший слот на границе, сразу за все готовые слоты после него.
+// Элемент создаётся до того, как занят слот, и переносится в слот перемещением без исключений,
+// поэтому бросивший конструктор не оставляет пустых слотов, на которых остановилась бы публикация.
+// Разрушать вектор можно только после завершения всех добавлений
+template <typename Type, size_t FirstChunkShift = 10>
+class ConcurrentVector {
+    static constexpr size_t MAX_CHUNKS = sizeof(size_t) * 8 - FirstChunkShift;
+
+    struct Slot {
+        std::atomic<bool> ready{false};
+        alignas(Type) unsigned char storage[sizeof(Type)];
+
+        Type* Get() noexcept {
+            return std::launder(reinterpret_cast<Type*>(storage));
+        }
+    };
+
+public:
+    class ConstIterator;
+
+    ConcurrentVector() noexcept = default;
+
+    ConcurrentVector(const ConcurrentVector&) = delete;
+    ConcurrentVector& operator=(const ConcurrentVector&) = delete;
+
+    ~ConcurrentVector() {
+        for (size_t chunk = 0; chunk < MAX_CHUNKS; ++chunk) {
+            Slot* slots = chunks_[chunk].load(std::memory_order_acquire);
+            if (slots == nullptr) {
+                continue;
+            }
+            for (size_t offset = 0; offset < ChunkSize(chunk); ++offset) {
+                if (slots[offset].ready.load(std::memory_order_relaxed)) {
+                    std::destroy_at(slots[offset].Get());
+                }
+            }
+            delete[] slots;
+        }
+    }
+
+    // Возвращает номер нового элемента. Сам элемент виден добавившему потоку сразу,
+    // остальным - когда GetSize() станет больше его номера.
+    // Если конструктор бросит исключение, вектор не изменится
+    template <typename... Args>
+    size_t EmplaceBack(Args&&... args) {
+        static_assert(std::is_nothrow_move_constructible_v<Type>,
+                      "ConcurrentVector moves a ready element into its slot and cannot roll back a reserved slot");
+        Type value(std::forward<Args>(args)...);
+        size_t index = reserved_.fetch_add(1);
+        Place(index, std::move(value));
+        return index;
+    }
+
+    size_t PushBack(const Type& value) {
+        return EmplaceBack(value);
+    }
+
+    size_t PushBack(Type&& value) {
+        return EmplaceBack(std::move(value));
+    }
+
+    // Выделяет куски под первые capacity элементов заранее, чтобы добавления не выделяли память
+    void Reserve(size_t capacity) {
+        if (capacity == 0) {
+            return;
+        }
+        auto [last_chunk, offset] = Locate(capacity - 1);
+        for (size_t chunk = 0; chunk <= last_chunk; ++chunk) {
+            GetChunk(chunk);
+        }
+    }
+
+    // Длина опубликованного префикса: все элементы [0, GetSize()) можно читать из любого потока
+    size_t GetSize() const noexcept {
+        return published_.load(std::memory_order_acquire);
+    }
+
+    // Сколько слотов уже занято, включая ещё не созданные элементы
+    size_t GetReservedSize() const noexcept {
+        return reserved_.load(std::memory_order_relaxed);
+    }
+
+    bool IsEmpty() const noexcept {
+        return GetSize() == 0;
+    }
+
+    const Type& operator[](size_t index) const noexcept {
+        auto [chunk, offset] = Locate(index);
+        Slot* slots = chunks_[chunk].load(std::memory_order_acquire);
+        assert(slots != nullptr && slots[offset].ready.load(std::memory_order_relaxed));
+        return *slots[offset].Get();
+    }
+
+    // Обход опубликованного префикса на момент вызова end()
+    ConstIterator begin() const noexcept {
+        return {this, 0};
+    }
+
+    ConstIterator end() const noexcept {
+        return {this, GetSize()};
+    }
+
+    class ConstIterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Type*;
+        using reference = const Type&;
+
+        ConstIterator() noexcept = default;
+
+        ConstIterator(const ConcurrentVector* owner, size_t index) noexcept
+        : owner_(owner), index_(index)
+        {
+        }
+
+        reference operator*() const noexcept {
+            return (*owner_)[index_];
+        }
+
+        pointer operator->() const noexcept {
+            return &**this;
+        }
+
+        ConstIterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+
+        ConstIterator operator++(int) noexcept {
+            ConstIterator old = *this;
+            ++index_;
+            return old;
+        }
+
+        bool operator==(const ConstIterator& other) const noexcept {
+            return index_ == other.index_;
+        }
+
+        bool operator!=(const ConstIterator& other) const noexcept {
+            return index_ != other.index_;
+        }
+
+    private:
+        const ConcurrentVector* owner_ = nullptr;
+        size_t index_ = 0;
+    };
+
+private:
+    static constexpr size_t ChunkSize(size_t chunk) noexcept {
+        return size_t(1) << (FirstChunkShift + chunk);
+    }
+
+    // Куски идут подряд с размерами 2^s, 2^(s+1), ..., поэтому index + 2^s начинается
+    // со старшего бита, номер которого и задаёт кусок
+    static std::pair<size_t, size_t> Locate(size_t index) noexcept {
+        size_t biased = index + ChunkSize(0);
+        size_t top_bit = sizeof(unsigned long long) * 8 - 1 - __builtin_clzll(biased);
+        size_t chunk = top_bit - FirstChunkShift;
+        return {chunk, biased - ChunkSize(chunk)};
+    }
+
+    // Заполняет занятый слот и публикует его. Отступить после резервирования нельзя: пустой слот
+    // навсегда остановил бы публикацию, поэтому нехватка памяти под новый кусок здесь завершает
+    // программу. Чтобы куски не выделялись во время добавлений, есть Reserve
+    void Place(size_t index, Type&& value) noexcept {
+        Slot& slot = GetSlot(index);
+        new (slot.storage) Type(std::move(value));
+        slot.ready.store(true);
+        Publish(index);
+    }
+
+    Slot& GetSlot(size_t index) {
+        auto [chunk, offset] = Locate(index);
+        return GetChunk(chunk)[offset];
+    }
+
+    // Кусок выделяет первый, кому он понадобился; проигравшие гонку освобождают свою копию
+    Slot* GetChunk(size_t chunk) {
+        Slot* slots = chunks_[chunk].load(std::memory_order_acquire);
+        if (slots != nullptr) {
+            return slots;
+        }
+        Slot* fresh = new Slot[ChunkSize(chunk)];
+        if (chunks_[chunk].compare_exchange_strong(slots, fresh, std::memory_order_acq_rel)) {
+            return fresh;
+        }
+        delete[] fresh;
+        return slots;
+    }
+
+    // Публикует готовый слот index. Границу сдвигает только поток, на чьём слоте она стоит: он
+    // проходит подряд все уже готовые слоты, а остальные потоки лишь читают границу и уходят.
+    // Поэтому запись в общую границу идёт раз на серию готовых слотов, а не на каждое добавление.
+    // Флаг готовности пишется до чтения границы, а граница сдвигается до проверки следующего флага;
+    // всё это seq_cst, поэтому для слота, на котором остановилась граница, хотя бы один из двух
+    // потоков увидит запись другого: либо его поток увидит границу на своём слоте, либо сдвигавший
+    // увидит его готовым. Если увидят оба, CAS пропустит дальше только одного
+    void Publish(size_t index) noexcept {
+        size_t published = index;
+        if (published_.load() != published) {
+            return;
+        }
+        while (true) {
+            if (!published_.compare_exchange_strong(published, published + 1)) {
+                return;
+            }
+            ++published;
+            auto [chunk, offset] = Locate(published);
+            Slot* slots = chunks_[chunk].load(std::memory_order_acquire);
+            if (slots == nullptr || !slots[offset].ready.load()) {
+                return;
+            }
+        }
+    }
+
+    std::atomic<Slot*> chunks_[MAX_CHUNKS] = {};
+    alignas(64) std::atomic<size_t> reserved_ = 0;
+    alignas(64) std::atomic<size_t> published_ = 0;
+};
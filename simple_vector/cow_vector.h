@@ -0,0 +1,264 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include "simple_vector.h"
+#include "span.h"
+
+// Вектор с общим буфером и копированием при записи: копия CowVector стоит O(1) и лишь
+// увеличивает счётчик ссылок, а буфер копируется, только когда один из владельцев его меняет.
+// Годится для больших, в основном читаемых данных, которые раздаются многим потребителям.
+// Чтение идёт через константные методы; неконстантные operator[], At, begin и end считаются
+// записью и сначала отделяют буфер. Ссылки и итераторы, полученные через них, нельзя
+// использовать после копирования вектора: запись через них попала бы и в копию.
+// Разные экземпляры можно использовать из разных потоков, даже если буфер у них общий;
+// один экземпляр - нет
+template <typename Type, typename Allocator = std::allocator<Type>>
+class CowVector {
+public:
+    using Vector = SimpleVector<Type, Allocator>;
+    using Iterator = typename Vector::Iterator;
+    using ConstIterator = typename Vector::ConstIterator;
+
+    CowVector() noexcept = default;
+
+    // Забирает содержимое готового вектора без копирования элементов
+    explicit CowVector(Vector&& items)
+    : shared_(new Shared(std::move(items)))
+    {
+    }
+
+    explicit CowVector(size_t size)
+    : CowVector(Vector(size))
+    {
+    }
+
+    CowVector(size_t size, const Type& value)
+    : CowVector(Vector(size, value))
+    {
+    }
+
+    CowVector(std::initializer_list<Type> init)
+    : CowVector(Vector(init))
+    {
+    }
+
+    CowVector(const CowVector& other) noexcept
+    : shared_(other.shared_)
+    {
+        if (shared_) {
+            shared_->owners.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    CowVector(CowVector&& other) noexcept
+    : shared_(std::exchange(other.shared_, nullptr))
+    {
+    }
+
+    CowVector& operator=(const CowVector& rhs) noexcept {
+        CowVector(rhs).swap(*this);
+        return *this;
+    }
+
+    CowVector& operator=(CowVector&& rhs) noexcept {
+        CowVector(std::move(rhs)).swap(*this);
+        return *this;
+    }
+
+    ~CowVector() {
+        Release();
+    }
+
+    // Число владельцев общего буфера; 0 у пустого вектора без буфера.
+    // Из-за других потоков к моменту использования оно может уже уменьшиться
+    long GetUseCount() const noexcept {
+        return shared_ ? shared_->owners.load(std::memory_order_relaxed) : 0;
+    }
+
+    // Чтение с захватом: если владелец один, все чтения буфера бывшими владельцами
+    // из других потоков завершились до этого момента, и буфер можно менять на месте
+    bool IsShared() const noexcept {
+        return shared_ && shared_->owners.load(std::memory_order_acquire) > 1;
+    }
+
+    size_t GetSize() const noexcept {
+        return shared_ ? shared_->items.GetSize() : 0;
+    }
+
+    size_t GetCapacity() const noexcept {
+        return shared_ ? shared_->items.GetCapacity() : 0;
+    }
+
+    bool IsEmpty() const noexcept {
+        return GetSize() == 0;
+    }
+
+    const Type& operator[](size_t index) const noexcept {
+        assert(index < GetSize());
+        return shared_->items[index];
+    }
+
+    const Type& At(size_t index) const {
+        if (index >= GetSize()) {
+            throw std::out_of_range("out_of_range");
+        }
+        return shared_->items[index];
+    }
+
+    Type& operator[](size_t index) {
+        assert(index < GetSize());
+        return Mutable()[index];
+    }
+
+    Type& At(size_t index) {
+        if (index >= GetSize()) {
+            throw std::out_of_range("out_of_range");
+        }
+        return Mutable()[index];
+    }
+
+    // Общий буфер только для чтения: без копирования, сколько бы владельцев ни было
+    Span<const Type> Subrange(size_t first, size_t count) const noexcept {
+        assert(first <= GetSize() && count <= GetSize() - first);
+        return {begin() + first, count};
+    }
+
+    // Вектор только для чтения, например для передачи в функции, принимающие SimpleVector
+    const Vector& Get() const {
+        return shared_ ? shared_->items : EmptyVector();
+    }
+
+    // Единоличный вектор для произвольных изменений; буфер отделяется, если он общий
+    Vector& Mutable() {
+        if (!shared_) {
+            shared_ = new Shared();
+        } else if (IsShared()) {
+            Shared* copy = new Shared(shared_->items);
+            Release();
+            shared_ = copy;
+        }
+        return shared_->items;
+    }
+
+    void Reserve(size_t new_capacity) {
+        Mutable().Reserve(new_capacity);
+    }
+
+    void PushBack(const Type& value) {
+        Mutable().PushBack(value);
+    }
+
+    void PushBack(Type&& value) {
+        Mutable().PushBack(std::move(value));
+    }
+
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        return Mutable().EmplaceBack(std::forward<Args>(args)...);
+    }
+
+    void PopBack() {
+        assert(!IsEmpty());
+        Mutable().PopBack();
+    }
+
+    // Позиция пересчитывается в индекс, так как после отделения буфера она указывает в чужой буфер
+    Iterator Insert(ConstIterator pos, const Type& value) {
+        size_t index = pos - cbegin();
+        Vector& items = Mutable();
+        return items.Insert(items.begin() + index, value);
+    }
+
+    Iterator Erase(ConstIterator pos) {
+        size_t index = pos - cbegin();
+        Vector& items = Mutable();
+        return items.Erase(items.begin() + index);
+    }
+
+    // Общий буфер не копируется, чтобы тут же стать пустым: вектор просто перестаёт им владеть
+    void Clear() {
+        if (IsShared()) {
+            Release();
+        } else if (shared_) {
+            shared_->items.Clear();
+        }
+    }
+
+    void Resize(size_t new_size) {
+        Mutable().Resize(new_size);
+    }
+
+    void swap(CowVector& other) noexcept {
+        std::swap(shared_, other.shared_);
+    }
+
+    Iterator begin() {
+        return Mutable().begin();
+    }
+
+    Iterator end() {
+        return Mutable().end();
+    }
+
+    ConstIterator begin() const noexcept {
+        return shared_ ? shared_->items.begin() : nullptr;
+    }
+
+    ConstIterator end() const noexcept {
+        return shared_ ? shared_->items.end() : nullptr;
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+private:
+    // Общий буфер со своим счётчиком владельцев. Не std::shared_ptr, потому что его use_count
+    // читается без упорядочивания: запись в буфер, который показался единоличным, могла бы
+    // обогнать чтение этого буфера в потоке, который только что от него отказался
+    struct Shared {
+        template <typename... Args>
+        explicit Shared(Args&&... args)
+        : items(std::forward<Args>(args)...)
+        {
+        }
+
+        std::atomic<long> owners{1};
+        Vector items;
+    };
+
+    static const Vector& EmptyVector() {
+        static const Vector empty;
+        return empty;
+    }
+
+    // Последний владелец освобождает буфер; освобождение упорядочено после чтений всех владельцев
+    void Release() noexcept {
+        Shared* shared = std::exchange(shared_, nullptr);
+        if (shared && shared->owners.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete shared;
+        }
+    }
+
+    Shared* shared_ = nullptr;
+};
+
+template <typename Type, typename Allocator>
+bool operator==(const CowVector<Type, Allocator>& lhs, const CowVector<Type, Allocator>& rhs) {
+    return lhs.Get() == rhs.Get();
+}
+
+template <typename Type, typename Allocator>
+bool operator!=(const CowVector<Type, Allocator>& lhs, const CowVector<Type, Allocator>& rhs) {
+    return !(lhs == rhs);
+}
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+
+// Счётчики выделений памяти и переносов элементов в SimpleVector.
+// Включаются макросом SIMPLE_VECTOR_INSTRUMENTATION, определённым до первого включения заголовков
+// (например, -DSIMPLE_VECTOR_INSTRUMENTATION). Без него все точки учёта - пустые встраиваемые функции,
+// и код векторов не отличается от собранного без этого заголовка.
+// Макрос должен быть одинаковым во всех единицах трансляции программы: от него зависят ENABLED
+// и тела шаблонов векторов, и при смешении компоновщик молча оставит одну из версий (нарушение ODR).
+// Поэтому тесты счётчиков - отдельная программа instrumentation_test.cpp, а не часть main.cpp.
+// События приписываются метке ближайшего активного Scope текущего потока: строке пользователя
+// или месту вызова, если Scope создан макросом SIMPLE_VECTOR_SCOPE()
+namespace instrumentation {
+
+#ifdef SIMPLE_VECTOR_INSTRUMENTATION
+inline constexpr bool ENABLED = true;
+#else
+inline constexpr bool ENABLED = false;
+#endif
+
+inline constexpr const char* UNTAGGED = "<untagged>";
+
+struct Counters {
+    size_t allocations = 0;
+    size_t bytes_allocated = 0;
+    // Переезды из существующего буфера в новый непустой буфер большей или меньшей вместимости.
+    // Первое выделение и освобождение буфера при сжатии до нуля сюда не входят
+    size_t reallocations = 0;
+    // Перенесённые при перевыделении элементы: побайтово, перемещением и копированием
+    size_t elements_relocated = 0;
+    size_t elements_moved = 0;
+    size_t elements_copied = 0;
+    // Самый большой буфер, выделенный под этой меткой
+    size_t peak_capacity_bytes = 0;
+};
+
+enum class Transfer {
+    RELOCATED,
+    MOVED,
+    COPIED,
+};
+
+// Метка задаётся указателем на строку, которая должна жить до конца Scope
+inline const char*& CurrentTag() noexcept {
+    thread_local const char* tag = nullptr;
+    return tag;
+}
+
+// Приписывает события векторов в этом потоке метке tag до выхода из области видимости
+class Scope {
+public:
+    explicit Scope(const char* tag) noexcept {
+        if constexpr (ENABLED) {
+            previous_ = std::exchange(CurrentTag(), tag);
+        }
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    ~Scope() {
+        if constexpr (ENABLED) {
+            CurrentTag() = previous_;
+        }
+    }
+
+private:
+    const char* previous_ = nullptr;
+};
+
+namespace detail {
+
+struct Registry {
+    std::mutex mutex;
+    std::map<std::string, Counters> counters;
+};
+
+inline Registry& GetRegistry() {
+    static Registry registry;
+    return registry;
+}
+
+template <typename Update>
+void Record(Update update) {
+    Registry& registry = GetRegistry();
+    const char* tag = CurrentTag();
+    std::lock_guard lock(registry.mutex);
+    update(registry.counters[tag != nullptr ? tag : UNTAGGED]);
+}
+
+}  // namespace detail
+
+inline void RecordAllocation(size_t bytes) {
+    if constexpr (ENABLED) {
+        detail::Record([bytes](Counters& counters) {
+            ++counters.allocations;
+            counters.bytes_allocated += bytes;
+            counters.peak_capacity_bytes = std::max(counters.peak_capacity_bytes, bytes);
+        });
+    }
+}
+
+inline void RecordReallocation(size_t old_capacity, size_t new_capacity) {
+    if constexpr (ENABLED) {
+        if (old_capacity == 0 || new_capacity == 0) {
+            return;
+        }
+        detail::Record([](Counters& counters) {
+            ++counters.reallocations;
+        });
+    }
+}
+
+inline void RecordTransfer(Transfer kind, size_t count) {
+    if constexpr (ENABLED) {
+        if (count == 0) {
+            return;
+        }
+        detail::Record([kind, count](Counters& counters) {
+            switch (kind) {
+            case Transfer::RELOCATED:
+                counters.elements_relocated += count;
+                break;
+            case Transfer::MOVED:
+                counters.elements_moved += count;
+                break;
+            case Transfer::COPIED:
+                counters.elements_copied += count;
+                break;
+            }
+        });
+    }
+}
+
+// Снимок всех счётчиков по меткам; без SIMPLE_VECTOR_INSTRUMENTATION всегда пуст
+inline std::map<std::string, Counters> GetReport() {
+    if constexpr (ENABLED) {
+        detail::Registry& registry = detail::GetRegistry();
+        std::lock_guard lock(registry.mutex);
+        return registry.counters;
+    } else {
+        return {};
+    }
+}
+
+inline void ResetReport() {
+    if constexpr (ENABLED) {
+        detail::Registry& registry = detail::GetRegistry();
+        std::lock_guard lock(registry.mutex);
+        registry.counters.clear();
+    }
+}
+
+inline void PrintReport(std::ostream& out) {
+    for (const auto& [tag, counters] : GetReport()) {
+        out << tag << ": allocations " << counters.allocations
+            << ", bytes " << counters.bytes_allocated
+            << ", reallocations " << counters.reallocations
+            << ", relocated " << counters.elements_relocated
+            << ", moved " << counters.elements_moved
+            << ", copied " << counters.elements_copied
+            << ", peak capacity bytes " << counters.peak_capacity_bytes << '\n';
+    }
+}
+
+}  // namespace instrumentation
+
+#define SIMPLE_VECTOR_STRINGIFY_IMPL(x) #x
+#define SIMPLE_VECTOR_STRINGIFY(x) SIMPLE_VECTOR_STRINGIFY_IMPL(x)
+#define SIMPLE_VECTOR_CONCAT_IMPL(a, b) a##b
+#define SIMPLE_VECTOR_CONCAT(a, b) SIMPLE_VECTOR_CONCAT_IMPL(a, b)
+
+// Метка - место вызова вида "file.cpp:42"
+#define SIMPLE_VECTOR_SCOPE() \
+    ::instrumentation::Scope SIMPLE_VECTOR_CONCAT(simple_vector_scope_, __LINE__)(__FILE__ ":" SIMPLE_VECTOR_STRINGIFY(__LINE__))
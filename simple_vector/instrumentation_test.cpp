@@ -0,0 +1,77 @@
+// Тесты счётчиков собираются отдельной программой: макрос SIMPLE_VECTOR_INSTRUMENTATION меняет код
+// векторов, и программа должна собираться с ним целиком (см. instrumentation.h)
+#define SIMPLE_VECTOR_INSTRUMENTATION
+
+#include "simple_vector.h"
+
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+using namespace std;
+
+static_assert(instrumentation::ENABLED);
+
+// Владеет объектом в куче и помечен как побайтово переносимый
+struct Owner {
+    explicit Owner(int value)
+        : ptr(make_unique<int>(value)) {
+    }
+    unique_ptr<int> ptr;
+};
+
+template <>
+struct IsTriviallyRelocatable<Owner> : true_type {
+};
+
+void TestInstrumentation() {
+    cout << "Test instrumentation" << endl;
+    instrumentation::ResetReport();
+    {
+        instrumentation::Scope scope("strings");
+        SimpleVector<string> strings;
+        for (int i = 0; i < 5; ++i) {
+            strings.PushBack(to_string(i));
+        }
+        SimpleVector<int> reserved;
+        reserved.Reserve(100);
+        {
+            SIMPLE_VECTOR_SCOPE();
+            reserved.Reserve(1000);
+        }
+        reserved.ShrinkToFit();
+    }
+    SimpleVector<Owner> owners;
+    owners.EmplaceBack(1);
+    owners.EmplaceBack(2);
+
+    auto report = instrumentation::GetReport();
+    const auto& strings = report.at("strings");
+    // буферы на 1, 2, 4, 8 строк и на 100 чисел; переезды только 1 -> 2 -> 4 -> 8:
+    // первые выделения и ShrinkToFit до нуля не переезды
+    assert(strings.allocations == 5 && strings.reallocations == 3);
+    assert(strings.elements_moved == 1 + 2 + 4);
+    assert(strings.elements_relocated == 0 && strings.elements_copied == 0);
+    assert(strings.peak_capacity_bytes == 100 * sizeof(int));
+    assert(report.size() == 3 && report.count(instrumentation::UNTAGGED) == 1);
+    for (const auto& [tag, counters] : report) {
+        if (tag.find("instrumentation_test.cpp:") != string::npos) {
+            assert(counters.allocations == 1 && counters.bytes_allocated == 1000 * sizeof(int));
+            assert(counters.reallocations == 1 && counters.elements_relocated == 0);
+        }
+    }
+    assert(report.at(instrumentation::UNTAGGED).elements_relocated == 1);
+    ostringstream out;
+    instrumentation::PrintReport(out);
+    assert(out.str().find("strings: allocations 5") != string::npos);
+    instrumentation::ResetReport();
+    assert(instrumentation::GetReport().empty());
+    cout << "Done!" << endl << endl;
+}
+
+int main() {
+    TestInstrumentation();
+    return 0;
+}
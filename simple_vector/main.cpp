@@ -1,8 +1,28 @@
 #include "simple_vector.h"
+#include "small_vector.h"
+#include "memory_resources.h"
+#include "aligned_allocator.h"
+#include "simd_algorithms.h"
+#include "mmap_vector.h"
+#include "soa_vector.h"
+#include "cow_vector.h"
+#include "segmented_vector.h"
+#include "concurrent_vector.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
 #include <iostream>
+#include <iterator>
+#include <memory>
 #include <numeric>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
 
 using namespace std;
 
@@ -31,6 +51,63 @@ private:
     size_t x_;
 };
 
+// Считает живые экземпляры; конструктора по умолчанию нет
+class Counted {
+public:
+    explicit Counted(int value)
+        : value_(value) {
+        ++alive;
+    }
+    Counted(const Counted& other)
+        : value_(other.value_) {
+        ++alive;
+    }
+    Counted(Counted&& other) noexcept
+        : value_(other.value_) {
+        ++alive;
+    }
+    Counted& operator=(const Counted& other) = default;
+    Counted& operator=(Counted&& other) noexcept = default;
+    ~Counted() {
+        --alive;
+    }
+    int GetValue() const {
+        return value_;
+    }
+
+    // Атомарный, потому что большие массивы создаются в нескольких потоках
+    static inline atomic<int> alive = 0;
+
+private:
+    int value_;
+};
+
+// Копирование бросает исключение, если источник - объект armed
+struct ThrowingCopy {
+    ThrowingCopy() = default;
+    ThrowingCopy(const ThrowingCopy& other)
+        : counted(other.counted) {
+        if (&other == armed) {
+            throw runtime_error("copy failed");
+        }
+    }
+    Counted counted{0};
+
+    static inline const ThrowingCopy* armed = nullptr;
+};
+
+// Владеет объектом в куче и помечен как побайтово переносимый
+struct Owner {
+    explicit Owner(int value)
+        : ptr(make_unique<int>(value)) {
+    }
+    unique_ptr<int> ptr;
+};
+
+template <>
+struct IsTriviallyRelocatable<Owner> : true_type {
+};
+
 SimpleVector<int> GenerateVector(size_t size) {
     SimpleVector<int> v(size);
     iota(v.begin(), v.end(), 1);
@@ -149,6 +226,858 @@ void TestNoncopiableErase() {
     cout << "Done!" << endl << endl;
 }
 
+void TestRawStorage() {
+    cout << "Test raw storage, no default construction" << endl;
+    {
+        SimpleVector<Counted> v(Reserve(100));
+        assert(Counted::alive == 0);
+        for (int i = 0; i < 10; ++i) {
+            v.PushBack(Counted(i));
+        }
+        assert(Counted::alive == 10);
+        v.Reserve(1000);
+        assert(Counted::alive == 10);
+        auto it = v.Insert(v.begin() + 5, Counted(100));
+        assert(it == v.begin() + 5 && it->GetValue() == 100);
+        assert(Counted::alive == 11);
+        v.Erase(v.begin());
+        v.PopBack();
+        assert(Counted::alive == 9);
+        v.PushBack(v[0]);
+        assert(v[9].GetValue() == v[0].GetValue());
+
+        SimpleVector<Counted> full(4, Counted(7));
+        auto mid = full.Insert(full.begin() + 2, full[0]);
+        assert(mid == full.begin() + 2 && full.GetSize() == 5);
+        assert(full[2].GetValue() == 7);
+    }
+    assert(Counted::alive == 0);
+    {
+        SimpleVector<int> v(3);
+        v.Resize(2);
+        v.Resize(5);
+        assert(v.GetSize() == 5 && v[4] == 0);
+        size_t capacity = v.GetCapacity();
+        v.Clear();
+        assert(v.IsEmpty() && v.GetCapacity() == capacity);
+    }
+    cout << "Done!" << endl << endl;
+}
+
+void TestEmplace() {
+    cout << "Test emplace" << endl;
+    struct Record {
+        Record(string name, int id)
+            : name(move(name)), id(id) {
+        }
+        string name;
+        int id;
+    };
+    SimpleVector<Record> v;
+    auto& first = v.EmplaceBack("first"s, 1);
+    assert(first.name == "first"s && first.id == 1);
+    v.EmplaceBack("third"s, 3);
+    auto it = v.Emplace(v.begin() + 1, "second"s, 2);
+    assert(it == v.begin() + 1 && it->name == "second"s);
+    assert(v.GetSize() == 3 && v[2].id == 3);
+
+    // аргумент ссылается на элемент вектора, который при росте переезжает
+    SimpleVector<string> strings{"a"s, "b"s};
+    assert(strings.GetSize() == strings.GetCapacity());
+    strings.EmplaceBack(strings[0]);
+    assert(strings[2] == "a"s);
+    strings.Emplace(strings.begin(), strings[1]);
+    assert(strings[0] == "b"s && strings[1] == "a"s);
+    strings.Reserve(10);
+    strings.Emplace(strings.begin(), strings[3]);
+    assert(strings[0] == "a"s && strings.GetSize() == 5);
+
+    // сдвиг хвоста бросает: элемент, созданный за концом, уже учтён в размере и не теряется
+    struct ThrowingAssign {
+        ThrowingAssign(int value, int* assignments_left)
+            : counted(value), assignments_left(assignments_left) {
+        }
+        ThrowingAssign(ThrowingAssign&&) = default;
+        ThrowingAssign& operator=(ThrowingAssign&& other) {
+            if ((*assignments_left)-- == 0) {
+                throw runtime_error("assign failed");
+            }
+            counted = move(other.counted);
+            return *this;
+        }
+        Counted counted;
+        int* assignments_left;
+    };
+    {
+        int assignments_left = 1000;
+        SimpleVector<ThrowingAssign> v;
+        v.Reserve(8);
+        for (int i = 0; i < 4; ++i) {
+            v.EmplaceBack(i, &assignments_left);
+        }
+        for (int budget : {1, 3}) {
+            assignments_left = budget;
+            try {
+                v.Emplace(v.begin(), 10, &assignments_left);
+                assert(false);
+            } catch (const runtime_error&) {
+            }
+            assert(Counted::alive == static_cast<int>(v.GetSize()));
+            assignments_left = 1000;
+            v.Insert(v.begin() + 1, ThrowingAssign(20, &assignments_left));
+            assert(Counted::alive == static_cast<int>(v.GetSize()));
+        }
+    }
+    assert(Counted::alive == 0);
+    cout << "Done!" << endl << endl;
+}
+
+void TestRelocation() {
+    cout << "Test relocation on growth" << endl;
+    SimpleVector<Owner> owners;
+    for (int i = 0; i < 100; ++i) {
+        owners.EmplaceBack(i);
+    }
+    owners.Insert(owners.begin() + 50, Owner(-1));
+    assert(owners.GetSize() == 101);
+    assert(*owners[49].ptr == 49 && *owners[50].ptr == -1 && *owners[51].ptr == 50);
+
+    struct Pod {
+        int a;
+        double b;
+    };
+    SimpleVector<Pod> pods;
+    for (int i = 0; i < 100; ++i) {
+        pods.PushBack({i, i * 0.5});
+    }
+    assert(pods[99].a == 99 && pods[99].b == 49.5);
+    cout << "Done!" << endl << endl;
+}
+
+void TestRangeEdits() {
+    cout << "Test range insert and erase" << endl;
+    // хвост длиннее и короче вставки, с перевыделением и без
+    SimpleVector<string> strings{"a"s, "b"s, "c"s, "d"s};
+    strings.Reserve(16);
+    const string extra[] = {"x"s, "y"s};
+    strings.Insert(strings.begin() + 1, begin(extra), end(extra));
+    assert((strings == SimpleVector<string>{"a"s, "x"s, "y"s, "b"s, "c"s, "d"s}));
+    strings.Insert(strings.end() - 1, {"p"s, "q"s, "r"s});
+    assert((strings == SimpleVector<string>{"a"s, "x"s, "y"s, "b"s, "c"s, "p"s, "q"s, "r"s, "d"s}));
+    strings.Erase(strings.begin() + 1, strings.begin() + 8);
+    assert((strings == SimpleVector<string>{"a"s, "d"s}));
+    // value ссылается на элемент самого вектора
+    auto it = strings.Insert(strings.begin(), 3, strings[1]);
+    assert(it == strings.begin());
+    assert((strings == SimpleVector<string>{"d"s, "d"s, "d"s, "a"s, "d"s}));
+    it = strings.Insert(strings.begin() + 2, 20, "z"s);
+    assert(strings.GetSize() == 25 && *it == "z"s && strings[22] == "d"s && strings[24] == "d"s);
+
+    // целочисленные аргументы выбирают Insert(pos, count, value)
+    SimpleVector<int> numbers{1, 2, 3};
+    numbers.Insert(numbers.begin() + 1, 2, 7);
+    assert((numbers == SimpleVector<int>{1, 7, 7, 2, 3}));
+    istringstream input("10 20 30");
+    numbers.Insert(numbers.begin(), istream_iterator<int>(input), istream_iterator<int>());
+    assert((numbers == SimpleVector<int>{10, 20, 30, 1, 7, 7, 2, 3}));
+    numbers.Erase(numbers.begin(), numbers.begin() + 3);
+    numbers.Erase(numbers.end(), numbers.end());
+    assert((numbers == SimpleVector<int>{1, 7, 7, 2, 3}));
+
+    // весь диапазон укладывается в одно перевыделение
+    SimpleVector<int> appended;
+    vector<int> source(1000);
+    iota(source.begin(), source.end(), 0);
+    appended.AppendRange(source.begin(), source.end());
+    assert(appended.GetCapacity() == 1000 && appended[999] == 999);
+
+    SimpleVector<Owner> owners;
+    owners.Reserve(8);
+    owners.EmplaceBack(1);
+    owners.EmplaceBack(2);
+    Owner moved[] = {Owner(3), Owner(4)};
+    owners.Insert(owners.begin() + 1, make_move_iterator(begin(moved)), make_move_iterator(end(moved)));
+    assert(*owners[0].ptr == 1 && *owners[1].ptr == 3 && *owners[2].ptr == 4 && *owners[3].ptr == 2);
+    owners.Erase(owners.begin(), owners.begin() + 2);
+    assert(owners.GetSize() == 2 && *owners[0].ptr == 4 && *owners[1].ptr == 2);
+
+    {
+        SimpleVector<Counted> counted;
+        counted.Insert(counted.end(), 5, Counted(1));
+        counted.Erase(counted.begin() + 1, counted.begin() + 4);
+        assert(counted.GetSize() == 2 && Counted::alive == 2);
+    }
+    assert(Counted::alive == 0);
+    cout << "Done!" << endl << endl;
+}
+
+void TestCapacityPolicies() {
+    cout << "Test capacity policies" << endl;
+    SimpleVector<int> v(10, 1);
+    v.Reserve(100);
+    v.ShrinkToFit();
+    assert(v.GetCapacity() == 10 && v.GetSize() == 10 && v[9] == 1);
+    v.Clear();
+    v.ShrinkToFit();
+    assert(v.GetCapacity() == 0 && v.begin() == nullptr);
+
+    // Resize в пределах вместимости не переносит элементы
+    SimpleVector<string> strings(4, "s"s);
+    strings.Reserve(16);
+    const string* data = strings.begin();
+    strings.Resize(2);
+    strings.Resize(16);
+    assert(strings.begin() == data && strings.GetCapacity() == 16);
+    assert(strings[1] == "s"s && strings[2].empty());
+
+    SimpleVector<int, allocator<int>, OneAndHalfGrowth> tight;
+    vector<size_t> capacities;
+    for (int i = 0; i < 20; ++i) {
+        tight.PushBack(i);
+        if (capacities.empty() || capacities.back() != tight.GetCapacity()) {
+            capacities.push_back(tight.GetCapacity());
+        }
+    }
+    assert((capacities == vector<size_t>{1, 2, 3, 4, 6, 9, 13, 19, 28}));
+
+    SimpleVector<int, allocator<int>, ChunkGrowth<1000>> chunked;
+    chunked.PushBack(1);
+    assert(chunked.GetCapacity() == 1000);
+    chunked.Resize(1500);
+    assert(chunked.GetCapacity() == 2000);
+    chunked.Insert(chunked.end(), 3000, 7);
+    assert(chunked.GetCapacity() == 4500 && chunked[4499] == 7);
+    // сравнения и алгоритмы работают с любой политикой
+    assert(chunked == chunked && Sum(chunked) == 21001);
+    cout << "Done!" << endl << endl;
+}
+
+void TestMmapVector() {
+    cout << "Test memory-mapped vector" << endl;
+    struct Record {
+        int id;
+        double value;
+    };
+    const string path = (filesystem::temp_directory_path() / "simple_vector_mmap_test.bin").string();
+    remove(path.c_str());
+    {
+        MmapVector<Record> records(path);
+        assert(records.IsEmpty() && records.GetMode() == MapMode::READ_WRITE);
+        for (int i = 0; i < 10000; ++i) {
+            records.PushBack({i, i * 0.5});
+        }
+        records.PushBack(records[0]);
+        records.Insert(records.begin(), {-1, -0.5});
+        records.Erase(records.end() - 1);
+        records.Sync();
+        assert(records.GetCapacity() >= records.GetSize());
+    }
+    // файл обрезан до размера, элементы читаются без копирования
+    assert(filesystem::file_size(path) == 10001 * sizeof(Record));
+    {
+        const MmapVector<Record> records(path, MapMode::READ_ONLY);
+        assert(records.GetSize() == 10001);
+        assert(records[0].id == -1 && records[10000].id == 9999 && records[10000].value == 4999.5);
+    }
+    {
+        MmapVector<Record> records(path, MapMode::READ_ONLY);
+        bool thrown = false;
+        try {
+            records.PushBack({0, 0.0});
+        } catch (const logic_error&) {
+            thrown = true;
+        }
+        assert(thrown && records.GetSize() == 10001);
+    }
+    {
+        MmapVector<Record> records(path);
+        records.Resize(3);
+        records.ShrinkToFit();
+        assert(records.GetCapacity() == 3);
+        Record more[] = {{7, 7.0}, {8, 8.0}};
+        records.AppendRange(begin(more), end(more));
+        MmapVector<Record> moved(move(records));
+        assert(moved.GetSize() == 5 && moved[4].id == 8);
+    }
+    assert(filesystem::file_size(path) == 5 * sizeof(Record));
+    bool thrown = false;
+    try {
+        MmapVector<Record> missing(path + ".missing", MapMode::READ_ONLY);
+    } catch (const system_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+    remove(path.c_str());
+    cout << "Done!" << endl << endl;
+}
+
+void TestParallelConstruct() {
+    cout << "Test parallel construct" << endl;
+    {
+        ThreadPool pool(3);
+        assert(pool.GetThreadCount() == 4);
+        vector<atomic<int>> runs(1000);
+        for (int round = 0; round < 10; ++round) {
+            pool.RunTasks(runs.size(), [&runs](size_t index) {
+                ++runs[index];
+            });
+        }
+        assert(all_of(runs.begin(), runs.end(), [](const atomic<int>& count) {
+            return count == 10;
+        }));
+
+        // вложенный вызов из задачи выполняется в том же потоке
+        atomic<int> nested = 0;
+        pool.RunTasks(8, [&pool, &nested](size_t) {
+            pool.RunTasks(4, [&nested](size_t) {
+                ++nested;
+            });
+        });
+        assert(nested == 32);
+    }
+
+    // типы, не копируемые побайтово, по умолчанию создаются последовательно
+    assert(ParallelNonTrivialThresholdBytes().load() == SIZE_MAX);
+    const size_t saved_threshold = ParallelThresholdBytes().load();
+    // порог занижен, чтобы даже небольшие массивы делились на куски
+    SetParallelThreshold(1);
+    SetParallelNonTrivialThreshold(1);
+    const size_t size = 3'000'000;
+    SimpleVector<int> filled(size, 7);
+    assert(Count(filled, 7) == size);
+    SimpleVector<int> copy(filled);
+    assert(copy == filled);
+    SimpleVector<int> zeros(size);
+    assert(Count(zeros, 0) == size);
+    copy.Resize(2 * size);
+    assert(copy[size - 1] == 7 && copy[2 * size - 1] == 0);
+
+    SimpleVector<string> strings(size / 2, "parallel"s);
+    SimpleVector<string> strings_copy(strings);
+    strings_copy.Reserve(size);
+    assert(strings_copy.GetSize() == size / 2 && strings_copy[size / 2 - 1] == "parallel"s);
+
+    // исключение в одном куске разрушает уже созданные куски
+    {
+        SimpleVector<Counted> counted(size, Counted(1));
+        assert(Counted::alive == static_cast<int>(size));
+        SimpleVector<ThrowingCopy> sources(size / 4);
+        ThrowingCopy::armed = &sources[size / 8];
+        bool thrown = false;
+        try {
+            SimpleVector<ThrowingCopy> copies(sources);
+        } catch (const runtime_error&) {
+            thrown = true;
+        }
+        assert(thrown && Counted::alive == static_cast<int>(size + size / 4));
+    }
+    assert(Counted::alive == 0);
+    SetParallelThreshold(saved_threshold);
+    SetParallelNonTrivialThreshold(0);
+    cout << "Done!" << endl << endl;
+}
+
+void TestSoaVector() {
+    cout << "Test structure of arrays" << endl;
+    SoaVector<int, double, string> rows;
+    rows.PushBack(1, 10.0, "one"s);
+    rows.PushBack(2, 20.0, "two"s);
+    rows.PushBack(4, 40.0, "four"s);
+    rows.Insert(2, 3, 30.0, "three"s);
+    assert(rows.GetSize() == 4 && rows.GetCapacity() >= 4);
+
+    // столбцы лежат подряд и читаются без копирования
+    Span<const double> prices = as_const(rows).Column<1>();
+    assert(prices.GetSize() == 4 && accumulate(prices.begin(), prices.end(), 0.0) == 100.0);
+    for (int& id : rows.Column<0>()) {
+        id *= 10;
+    }
+
+    // прокси-ссылка пишет в столбцы
+    auto [id, price, name] = rows[2];
+    assert(id == 30 && price == 30.0 && name == "three"s);
+    price = 33.0;
+    assert(rows.Column<1>()[2] == 33.0);
+    rows[0] = rows.GetRow(3);
+    assert(rows.GetRow(0) == make_tuple(40, 40.0, "four"s));
+
+    rows.Erase(0, 2);
+    assert(rows.GetSize() == 2 && get<2>(rows[0]) == "three"s);
+    int total = 0;
+    for (auto row : rows) {
+        total += get<0>(row);
+    }
+    assert(total == 70);
+
+    SoaVector<int, double, string> copy = rows;
+    assert(copy == rows);
+    copy.PopBack();
+    copy.Resize(3);
+    assert(copy != rows && get<2>(copy[2]).empty());
+
+    // значения могут ссылаться на строки самого вектора, в том числе при перевыделении столбцов
+    {
+        SoaVector<string, int> aliased;
+        aliased.PushBack("a long string that does not fit into SSO"s, 1);
+        for (int i = 0; i < 20; ++i) {
+            aliased.PushBack(aliased.Column<0>()[0], i);
+            aliased.Insert(0, aliased.Column<0>()[aliased.GetSize() - 1], get<1>(aliased[0]));
+        }
+        for (const string& value : aliased.Column<0>()) {
+            assert(value == "a long string that does not fit into SSO"s);
+        }
+        assert(aliased.GetSize() == 41 && get<1>(aliased[0]) == 1);
+    }
+
+    // исключение в конструкторе поля откатывает уже добавленные поля строки
+    {
+        SoaVector<Counted, ThrowingCopy> mixed;
+        ThrowingCopy bad;
+        ThrowingCopy::armed = &bad;
+        mixed.PushBack(Counted(1), ThrowingCopy());
+        bool thrown = false;
+        try {
+            mixed.PushBack(Counted(2), bad);
+        } catch (const runtime_error&) {
+            thrown = true;
+        }
+        ThrowingCopy::armed = nullptr;
+        assert(thrown && mixed.GetSize() == 1 && get<0>(mixed[0]).GetValue() == 1);
+    }
+    assert(Counted::alive == 0);
+    cout << "Done!" << endl << endl;
+}
+
+void TestSpansAndSharing() {
+    cout << "Test spans and copy-on-write" << endl;
+    SimpleVector<int> numbers(10);
+    iota(numbers.begin(), numbers.end(), 0);
+    Span<int> middle = numbers.Subrange(2, 5);
+    assert(middle.GetSize() == 5 && middle[0] == 2 && middle.Data() == numbers.begin() + 2);
+    middle[1] = 30;
+    assert(numbers[3] == 30);
+    Span<const int> tail = as_const(numbers).Subrange(7, 3).Subspan(1, 2);
+    assert(tail.GetSize() == 2 && tail[0] == 8 && tail[1] == 9);
+    assert(numbers.Subrange(10, 0).IsEmpty());
+
+    CowVector<string> original{"a"s, "b"s, "c"s};
+    CowVector<string> copy = original;
+    assert(copy.IsShared() && original.GetUseCount() == 2);
+    assert(&as_const(copy)[0] == &as_const(original)[0]);
+    Span<const string> view = as_const(copy).Subrange(1, 2);
+    assert(view[0] == "b"s);
+
+    // первая запись отделяет буфер, остальные владельцы его не видят
+    copy.PushBack("d"s);
+    assert(!copy.IsShared() && !original.IsShared());
+    assert(original.GetSize() == 3 && copy.GetSize() == 4 && view[1] == "c"s);
+    copy[0] = "z"s;
+    assert(as_const(original)[0] == "a"s);
+    CowVector<string> third = copy;
+    third.Erase(third.cbegin());
+    assert(copy.GetSize() == 4 && third.GetSize() == 3 && as_const(third)[0] == "b"s);
+    third.Insert(third.cbegin(), "y"s);
+    assert(third != copy && as_const(third)[0] == "y"s);
+
+    // пустой общий буфер не копируется
+    CowVector<string> cleared = original;
+    cleared.Clear();
+    assert(cleared.IsEmpty() && cleared.GetUseCount() == 0 && original.GetSize() == 3);
+    CowVector<int> empty;
+    assert(empty.IsEmpty() && empty.cbegin() == empty.cend() && empty.Get().IsEmpty());
+    empty.EmplaceBack(1);
+    assert(empty == CowVector<int>{1});
+
+    // владельцы из других потоков отказываются от буфера, после чего запись идёт без копирования
+    {
+        CowVector<int> shared(SimpleVector<int>(1000, 1));
+        atomic<long long> total = 0;
+        vector<thread> readers;
+        for (int i = 0; i < 4; ++i) {
+            readers.emplace_back([copy = shared, &total]() mutable {
+                total += accumulate(copy.cbegin(), copy.cend(), 0LL);
+                copy = CowVector<int>();
+            });
+        }
+        while (shared.IsShared()) {
+            this_thread::yield();
+        }
+        const int* data = shared.cbegin();
+        shared[0] = 2;
+        assert(shared.cbegin() == data && shared.GetUseCount() == 1);
+        for (thread& reader : readers) {
+            reader.join();
+        }
+        assert(total == 4000);
+    }
+    cout << "Done!" << endl << endl;
+}
+
+// Без SIMPLE_VECTOR_INSTRUMENTATION точки учёта пусты, а отчёт всегда пуст
+void TestInstrumentationDisabled() {
+    cout << "Test instrumentation disabled" << endl;
+    static_assert(!instrumentation::ENABLED);
+    {
+        instrumentation::Scope scope("strings");
+        SimpleVector<string> strings;
+        strings.PushBack("one"s);
+        strings.Reserve(10);
+    }
+    assert(instrumentation::GetReport().empty());
+    cout << "Done!" << endl << endl;
+}
+
+void TestSegmentedVector() {
+    cout << "Test segmented vector" << endl;
+    // куски по 4 элемента, чтобы граница кусков встречалась часто
+    SegmentedVector<string, 2> strings;
+    strings.PushBack("first"s);
+    const string* first = &strings[0];
+    for (int i = 1; i < 100; ++i) {
+        strings.EmplaceBack(to_string(i));
+    }
+    // рост не переносит элементы
+    assert(&strings[0] == first && *first == "first"s);
+    assert(strings.GetSize() == 100 && strings.GetCapacity() == 100);
+    strings.EmplaceBack(strings[0]);
+    assert(strings[100] == "first"s && strings.GetCapacity() == 104);
+
+    auto it = strings.Insert(strings.begin() + 2, "inserted"s);
+    assert(*it == "inserted"s && strings[3] == "2"s && strings.GetSize() == 102);
+    it = strings.Erase(strings.begin());
+    assert(*it == "1"s && strings[1] == "inserted"s);
+    assert(find(strings.begin(), strings.end(), "50"s) - strings.begin() == 50);
+    sort(strings.begin(), strings.end());
+    assert(is_sorted(strings.cbegin(), strings.cend()));
+
+    SegmentedVector<string, 2> copy = strings;
+    assert(copy == strings);
+    copy.Resize(5);
+    copy.ShrinkToFit();
+    assert(copy.GetSize() == 5 && copy.GetCapacity() == 8 && copy[4] == strings[4]);
+    copy.Clear();
+    assert(copy.IsEmpty() && copy != strings);
+
+    SegmentedVector<int> numbers(10'000, 7);
+    assert(SegmentedVector<int>::CHUNK_SIZE * sizeof(int) == 64 * 1024);
+    assert(numbers.GetCapacity() == SegmentedVector<int>::CHUNK_SIZE && numbers.At(9'999) == 7);
+    {
+        SegmentedVector<Counted, 1> counted{Counted(1), Counted(2), Counted(3)};
+        counted.PopBack();
+        assert(Counted::alive == 2);
+    }
+    assert(Counted::alive == 0);
+    cout << "Done!" << endl << endl;
+}
+
+void TestConcurrentVector() {
+    cout << "Test concurrent append-only vector" << endl;
+    const int producers = 4;
+    const int per_producer = 20'000;
+    ConcurrentVector<string, 4> results;
+    atomic<bool> done = false;
+    // читатель всё время видит только полностью созданные элементы
+    thread reader([&] {
+        size_t seen = 0;
+        while (!done) {
+            size_t size = 0;
+            for (const string& value : results) {
+                assert(!value.empty());
+                ++size;
+            }
+            assert(size >= seen);
+            seen = size;
+        }
+    });
+    vector<thread> writers;
+    for (int producer = 0; producer < producers; ++producer) {
+        writers.emplace_back([&results, producer] {
+            for (int i = 0; i < per_producer; ++i) {
+                size_t index = results.PushBack(to_string(producer * per_producer + i));
+                assert(stoi(results[index]) == producer * per_producer + i);
+            }
+        });
+    }
+    for (thread& writer : writers) {
+        writer.join();
+    }
+    done = true;
+    reader.join();
+
+    const size_t total = producers * per_producer;
+    assert(results.GetSize() == total && results.GetReservedSize() == total);
+    vector<bool> found(total);
+    for (const string& value : results) {
+        found[stoi(value)] = true;
+    }
+    assert(all_of(found.begin(), found.end(), [](bool present) {
+        return present;
+    }));
+
+    ConcurrentVector<Counted> counted;
+    counted.Reserve(5000);
+    for (int i = 0; i < 5000; ++i) {
+        counted.EmplaceBack(i);
+    }
+    assert(counted[4999].GetValue() == 4999 && Counted::alive == 5000);
+
+    // брошенное конструктором исключение не останавливает публикацию следующих элементов
+    {
+        struct Positive {
+            explicit Positive(int value)
+                : value(value) {
+                if (value % 10 == 0) {
+                    throw invalid_argument("not accepted");
+                }
+            }
+            int value;
+        };
+        ConcurrentVector<Positive, 4> accepted;
+        atomic<int> rejected = 0;
+        vector<thread> appenders;
+        for (int producer = 0; producer < producers; ++producer) {
+            appenders.emplace_back([&accepted, &rejected, producer] {
+                for (int i = 0; i < 1000; ++i) {
+                    try {
+                        accepted.EmplaceBack(producer * 1000 + i);
+                    } catch (const invalid_argument&) {
+                        ++rejected;
+                    }
+                }
+            });
+        }
+        for (thread& appender : appenders) {
+            appender.join();
+        }
+        assert(rejected == producers * 100);
+        assert(accepted.GetSize() == producers * 900u && accepted.GetReservedSize() == accepted.GetSize());
+        int sum = 0;
+        for (const Positive& positive : accepted) {
+            assert(positive.value % 10 != 0);
+            ++sum;
+        }
+        assert(sum == producers * 900);
+    }
+    cout << "Done!" << endl << endl;
+}
+
+void TestSmallVector() {
+    cout << "Test small vector" << endl;
+    {
+        SmallVector<Counted, 4> v;
+        for (int i = 0; i < 4; ++i) {
+            v.EmplaceBack(i);
+        }
+        assert(v.IsInline() && v.GetCapacity() == 4u);
+        v.Insert(v.begin() + 1, Counted(10));
+        assert(!v.IsInline() && v.GetSize() == 5u);
+        assert(v[1].GetValue() == 10 && v[4].GetValue() == 3);
+        assert(Counted::alive == 5);
+
+        SmallVector<Counted, 4> small;
+        small.EmplaceBack(100);
+
+        // встроенный и куча меняются местами
+        v.swap(small);
+        assert(v.IsInline() && v.GetSize() == 1u && v[0].GetValue() == 100);
+        assert(!small.IsInline() && small.GetSize() == 5u && small[1].GetValue() == 10);
+        assert(Counted::alive == 6);
+
+        SmallVector<Counted, 4> moved_heap(move(small));
+        assert(!moved_heap.IsInline() && moved_heap.GetSize() == 5u && small.IsEmpty());
+        SmallVector<Counted, 4> moved_inline(move(v));
+        assert(moved_inline.IsInline() && moved_inline[0].GetValue() == 100 && v.IsEmpty());
+        assert(Counted::alive == 6);
+
+        SmallVector<Counted, 4> a{Counted(1), Counted(2), Counted(3)};
+        SmallVector<Counted, 4> b{Counted(4)};
+        a.swap(b);
+        assert(a.GetSize() == 1u && a[0].GetValue() == 4);
+        assert(b.GetSize() == 3u && b[2].GetValue() == 3);
+        moved_heap = move(a);
+        assert(moved_heap.GetSize() == 1u && moved_heap[0].GetValue() == 4);
+        assert(Counted::alive == 5);
+
+        auto copy = b;
+        copy.Erase(copy.begin());
+        copy.PopBack();
+        assert(copy.GetSize() == 1u && copy[0].GetValue() == 2);
+    }
+    assert(Counted::alive == 0);
+    {
+        SmallVector<int, 2> v{1, 2, 3};
+        v.Resize(5);
+        assert(v.GetSize() == 5u && v[4] == 0);
+        assert((v == SmallVector<int, 2>{1, 2, 3, 0, 0}));
+        assert((SmallVector<int, 2>{1, 2} < SmallVector<int, 2>{1, 3}));
+    }
+    cout << "Done!" << endl << endl;
+}
+
+void TestMemoryResources() {
+    cout << "Test memory resources" << endl;
+    MonotonicArena arena(256);
+    SizeClassPool pool;
+    {
+        PmrSimpleVector<string> v(&arena);
+        for (int i = 0; i < 100; ++i) {
+            v.PushBack(to_string(i));
+        }
+        assert(v.GetAllocator().resource() == &arena);
+        assert(arena.GetReservedBytes() > 0);
+
+        // копия остаётся на аллокаторе того вектора, в который копируют
+        PmrSimpleVector<string> copy(&pool);
+        copy = v;
+        assert(copy == v && copy.GetAllocator().resource() == &pool);
+
+        // буфер из другого ресурса не переезжает, элементы переносятся поштучно
+        PmrSimpleVector<string> moved(&pool);
+        moved = move(v);
+        assert(moved.GetSize() == 100u && moved[99] == "99"s);
+        assert(moved.GetAllocator().resource() == &pool);
+
+        PmrSimpleVector<string> stolen(move(moved));
+        assert(stolen.GetSize() == 100u && moved.IsEmpty());
+        assert(stolen.GetAllocator().resource() == &pool);
+        stolen.Insert(stolen.begin(), "front"s);
+        assert(stolen[0] == "front"s && stolen.GetSize() == 101u);
+    }
+    arena.Release();
+    assert(arena.GetReservedBytes() == 0u);
+    pool.Release();
+
+    // крупные и сверхвыровненные выделения идут мимо классов размеров, но Release() возвращает и их
+    struct CountingResource : std::pmr::memory_resource {
+        size_t outstanding = 0;
+
+        void* do_allocate(size_t bytes, size_t alignment) override {
+            ++outstanding;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+        void do_deallocate(void* ptr, size_t bytes, size_t alignment) override {
+            --outstanding;
+            std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+        }
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+    };
+    CountingResource upstream;
+    {
+        SizeClassPool counted_pool(&upstream);
+        void* large = counted_pool.allocate(SizeClassPool::MAX_CLASS + 1);
+        void* aligned = counted_pool.allocate(64, 128);
+        void* huge = counted_pool.allocate(SizeClassPool::MAX_CLASS * 2);
+        assert(huge != large && reinterpret_cast<uintptr_t>(aligned) % 128 == 0);
+        assert(upstream.outstanding == 3u);
+        counted_pool.deallocate(large, SizeClassPool::MAX_CLASS + 1);
+        assert(upstream.outstanding == 2u);
+        counted_pool.Release();
+        assert(upstream.outstanding == 0u);
+
+        large = counted_pool.allocate(SizeClassPool::MAX_CLASS + 1);
+        void* small = counted_pool.allocate(32);
+        assert(large != small && upstream.outstanding == 2u);
+    }
+    assert(upstream.outstanding == 0u);
+    cout << "Done!" << endl << endl;
+}
+
+void TestAlignedStorage() {
+    cout << "Test aligned storage" << endl;
+    auto is_aligned = [](const void* ptr, size_t alignment) {
+        return reinterpret_cast<uintptr_t>(ptr) % alignment == 0;
+    };
+    AlignedVector<float, 64> floats;
+    for (int i = 0; i < 1000; ++i) {
+        floats.PushBack(static_cast<float>(i));
+        assert(is_aligned(floats.begin(), 64));
+    }
+    AlignedVector<double, 64> copy(4, 1.5);
+    assert(is_aligned(copy.begin(), 64));
+
+    const size_t huge_size = HUGE_PAGE_SIZE / sizeof(double) * 3;
+    HugePageVector<double> huge(huge_size, 2.0);
+    assert(is_aligned(huge.begin(), HUGE_PAGE_SIZE));
+    huge.PushBack(3.0);
+    assert(is_aligned(huge.begin(), HUGE_PAGE_SIZE));
+    assert(huge[0] == 2.0 && huge[huge_size] == 3.0);
+
+    HugePageVector<double, 64, HugePageMode::EXPLICIT> explicit_huge(huge_size, 4.0);
+    assert(is_aligned(explicit_huge.begin(), HUGE_PAGE_SIZE) && explicit_huge[huge_size - 1] == 4.0);
+
+    HugePageVector<double> small(10, 1.0);
+    assert(is_aligned(small.begin(), 64));
+    cout << "Done!" << endl << endl;
+}
+
+template <typename Type>
+void CheckSimdAlgorithms(size_t size) {
+    SimpleVector<Type> v(size);
+    SimpleVector<Type> w(size);
+    for (size_t i = 0; i < size; ++i) {
+        v[i] = static_cast<Type>((i * 7) % 13);
+        w[i] = static_cast<Type>((i * 3) % 5);
+    }
+    Type sum{};
+    Type dot{};
+    size_t count = 0;
+    for (size_t i = 0; i < size; ++i) {
+        sum += v[i];
+        dot += v[i] * w[i];
+        count += v[i] == Type(4);
+    }
+    assert(Sum(v) == sum);
+    assert(Dot(v, w) == dot);
+    assert(Count(v, Type(4)) == count);
+    assert(Find(v, Type(4)) == find(v.begin(), v.end(), Type(4)));
+    assert(Find(v, Type(100)) == v.end());
+    if (size > 0) {
+        auto [min, max] = MinMax(v);
+        assert(min == *min_element(v.begin(), v.end()) && max == *max_element(v.begin(), v.end()));
+    }
+
+    auto scaled = v;
+    Scale(scaled, Type(2));
+    Add(scaled, w);
+    for (size_t i = 0; i < size; ++i) {
+        assert(scaled[i] == static_cast<Type>(v[i] * Type(2) + w[i]));
+    }
+
+    auto copy = v;
+    assert(copy == v && !(copy != v) && !(copy < v) && copy <= v && copy >= v);
+    if (size > 0) {
+        copy[size - 1] = static_cast<Type>(copy[size - 1] + 1);
+        assert(copy != v && v < copy && copy > v && v <= copy && !(v >= copy));
+        copy.PopBack();
+        assert(copy < v && v > copy);
+    }
+}
+
+void TestSimdAlgorithms() {
+    cout << "Test SIMD algorithms" << endl;
+    const simd::Level detected = simd::GetLevel();
+    for (auto level : {simd::Level::SCALAR, simd::Level::SSE2, simd::Level::AVX2, simd::Level::AVX512}) {
+        simd::SetLevel(level);
+        for (size_t size : {0, 1, 7, 64, 1000, 4099}) {
+            CheckSimdAlgorithms<int>(size);
+            CheckSimdAlgorithms<unsigned char>(size);
+            CheckSimdAlgorithms<int64_t>(size);
+            CheckSimdAlgorithms<float>(size);
+            CheckSimdAlgorithms<double>(size);
+        }
+    }
+    simd::SetLevel(detected);
+
+    SimpleVector<double> with_nan{1.0, NAN, 2.0};
+    SimpleVector<double> other{1.0, NAN, 3.0};
+    assert(with_nan != with_nan);
+    assert(with_nan < other);
+    assert((SimpleVector<string>{"a"s, "b"s} < SimpleVector<string>{"a"s, "c"s}));
+    cout << "Done!" << endl << endl;
+}
+
 int main() {
     TestTemporaryObjConstructor();
     TestTemporaryObjOperator();
@@ -158,5 +1087,21 @@ int main() {
     TestNoncopiablePushBack();
     TestNoncopiableInsert();
     TestNoncopiableErase();
+    TestRawStorage();
+    TestEmplace();
+    TestRelocation();
+    TestRangeEdits();
+    TestCapacityPolicies();
+    TestMmapVector();
+    TestParallelConstruct();
+    TestSoaVector();
+    TestSpansAndSharing();
+    TestInstrumentationDisabled();
+    TestSegmentedVector();
+    TestConcurrentVector();
+    TestSmallVector();
+    TestMemoryResources();
+    TestAlignedStorage();
+    TestSimdAlgorithms();
     return 0;
 }
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+#include "simple_vector.h"
+
+// SimpleVector, который берёт память у std::pmr::memory_resource
+template <typename Type>
+using PmrSimpleVector = SimpleVector<Type, std::pmr::polymorphic_allocator<Type>>;
+
+// Монотонная арена: раздаёт память из крупных блоков сдвигом указателя, освобождение отдельных
+// выделений ничего не делает. Вся память возвращается разом в Release() или в деструкторе -
+// например, когда запрос обработан и все его векторы больше не нужны
+class MonotonicArena : public std::pmr::memory_resource {
+public:
+    explicit MonotonicArena(size_t initial_block_size = 64 * 1024,
+                            std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : initial_block_size_(std::max(initial_block_size, size_t(64)))
+        , next_block_size_(initial_block_size_)
+        , upstream_(upstream) {
+    }
+
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    ~MonotonicArena() override {
+        Release();
+    }
+
+    // Возвращает все блоки вышестоящему ресурсу. Выделенная из арены память становится недействительной
+    void Release() noexcept {
+        for (const auto& block : blocks_) {
+            upstream_->deallocate(block.data, block.size, alignof(std::max_align_t));
+        }
+        blocks_.clear();
+        current_ = nullptr;
+        left_ = 0;
+        next_block_size_ = initial_block_size_;
+    }
+
+    // Сколько байт взято у вышестоящего ресурса
+    size_t GetReservedBytes() const noexcept {
+        size_t total = 0;
+        for (const auto& block : blocks_) {
+            total += block.size;
+        }
+        return total;
+    }
+
+private:
+    struct Block {
+        void* data;
+        size_t size;
+    };
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        void* ptr = current_;
+        if (!std::align(alignment, bytes, ptr, left_)) {
+            // Каждый следующий блок вдвое больше предыдущего, чтобы блоков было мало
+            size_t block_size = std::max(next_block_size_, bytes + alignment);
+            // Место под блок занимается до выделения, иначе бросивший push_back потерял бы блок
+            blocks_.push_back({nullptr, block_size});
+            void* data;
+            try {
+                data = upstream_->allocate(block_size, alignof(std::max_align_t));
+            } catch (...) {
+                blocks_.pop_back();
+                throw;
+            }
+            blocks_.back().data = data;
+            next_block_size_ = block_size * 2;
+            current_ = data;
+            left_ = block_size;
+            ptr = current_;
+            std::align(alignment, bytes, ptr, left_);
+        }
+        current_ = static_cast<char*>(ptr) + bytes;
+        left_ -= bytes;
+        return ptr;
+    }
+
+    void do_deallocate(void*, size_t, size_t) override {
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    std::vector<Block> blocks_;
+    void* current_ = nullptr;
+    size_t left_ = 0;
+    size_t initial_block_size_;
+    size_t next_block_size_;
+    std::pmr::memory_resource* upstream_;
+};
+
+// Пул с классами размеров: запрос округляется вверх до степени двойки от MIN_CLASS до MAX_CLASS байт,
+// для каждого класса ведётся список свободных кусков, нарезанных из общих блоков.
+// Освобождённый кусок сразу переиспользуется, крупные запросы идут напрямую к вышестоящему ресурсу,
+// но пул их запоминает. Release() возвращает разом все блоки и все ещё не освобождённые крупные выделения
+class SizeClassPool : public std::pmr::memory_resource {
+public:
+    static constexpr size_t MIN_CLASS = 16;
+    static constexpr size_t MAX_CLASS = 64 * 1024;
+    static constexpr size_t BLOCK_SIZE = 256 * 1024;
+
+    explicit SizeClassPool(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : upstream_(upstream) {
+    }
+
+    SizeClassPool(const SizeClassPool&) = delete;
+    SizeClassPool& operator=(const SizeClassPool&) = delete;
+
+    ~SizeClassPool() override {
+        Release();
+    }
+
+    void Release() noexcept {
+        for (void* block : blocks_) {
+            upstream_->deallocate(block, BLOCK_SIZE, alignof(std::max_align_t));
+        }
+        blocks_.clear();
+        for (const auto& allocation : large_) {
+            upstream_->deallocate(allocation.data, allocation.size, allocation.alignment);
+        }
+        large_.clear();
+        std::fill(std::begin(free_lists_), std::end(free_lists_), nullptr);
+    }
+
+private:
+    struct FreeChunk {
+        FreeChunk* next;
+    };
+
+    // Выделение в обход классов размеров: его нужно вернуть с тем же размером и выравниванием
+    struct LargeAllocation {
+        void* data;
+        size_t size;
+        size_t alignment;
+    };
+
+    static constexpr size_t CLASSES_COUNT = 13;  // 16, 32, ..., 64 KiB
+
+    static size_t ClassIndex(size_t bytes) noexcept {
+        size_t index = 0;
+        size_t class_size = MIN_CLASS;
+        while (class_size < bytes) {
+            class_size *= 2;
+            ++index;
+        }
+        return index;
+    }
+
+    static bool IsPooled(size_t bytes, size_t alignment) noexcept {
+        return bytes <= MAX_CLASS && alignment <= alignof(std::max_align_t);
+    }
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        if (!IsPooled(bytes, alignment)) {
+            // Место в large_ занимается до выделения, чтобы запоминание не могло бросить после него
+            large_.push_back({nullptr, bytes, alignment});
+            try {
+                large_.back().data = upstream_->allocate(bytes, alignment);
+            } catch (...) {
+                large_.pop_back();
+                throw;
+            }
+            return large_.back().data;
+        }
+        size_t index = ClassIndex(bytes);
+        if (!free_lists_[index]) {
+            Refill(index);
+        }
+        FreeChunk* chunk = free_lists_[index];
+        free_lists_[index] = chunk->next;
+        return chunk;
+    }
+
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override {
+        if (!IsPooled(bytes, alignment)) {
+            auto it = std::find_if(large_.begin(), large_.end(), [ptr](const LargeAllocation& allocation) {
+                return allocation.data == ptr;
+            });
+            assert(it != large_.end());
+            *it = large_.back();
+            large_.pop_back();
+            upstream_->deallocate(ptr, bytes, alignment);
+            return;
+        }
+        size_t index = ClassIndex(bytes);
+        free_lists_[index] = new (ptr) FreeChunk{free_lists_[index]};
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    // Нарезает новый блок на куски одного класса
+    void Refill(size_t index) {
+        size_t class_size = MIN_CLASS << index;
+        blocks_.push_back(nullptr);
+        char* block;
+        try {
+            block = static_cast<char*>(upstream_->allocate(BLOCK_SIZE, alignof(std::max_align_t)));
+        } catch (...) {
+            blocks_.pop_back();
+            throw;
+        }
+        blocks_.back() = block;
+        for (size_t offset = 0; offset + class_size <= BLOCK_SIZE; offset += class_size) {
+            free_lists_[index] = new (block + offset) FreeChunk{free_lists_[index]};
+        }
+    }
+
+    std::pmr::memory_resource* upstream_;
+    std::vector<void*> blocks_;
+    std::vector<LargeAllocation> large_;
+    FreeChunk* free_lists_[CLASSES_COUNT] = {};
+};
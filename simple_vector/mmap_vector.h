@@ -0,0 +1,352 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include "simple_vector.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+enum class MapMode {
+    // Файл только читается; изменяющие размер методы бросают std::logic_error
+    READ_ONLY,
+    // Изменения пишутся прямо в файл; файл создаётся, если его нет
+    READ_WRITE,
+};
+
+// Вектор поверх отображённого в память файла: элементы лежат в файле подряд, без заголовка,
+// и при открытии ничего не читается и не копируется - страницы подгружает и вытесняет ядро.
+// Подходит только для тривиально копируемых типов: их байты в файле и есть объекты.
+// В режиме READ_WRITE файл растёт через ftruncate + mremap по GrowthPolicy, а в деструкторе
+// обрезается до GetSize() элементов; до этого хвост файла может содержать нули из запаса вместимости.
+// Запись на диск гарантирует только Sync(), иначе её делает ядро в удобное ему время.
+// Ошибки системных вызовов сообщаются через std::system_error
+template <typename Type, typename GrowthPolicy = DoublingGrowth>
+class MmapVector {
+    static_assert(std::is_trivially_copyable_v<Type>, "MmapVector stores raw bytes of the elements");
+
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+
+    explicit MmapVector(const std::string& path, MapMode mode = MapMode::READ_WRITE)
+    : mode_(mode)
+    {
+        int flags = mode == MapMode::READ_ONLY ? O_RDONLY : O_RDWR | O_CREAT;
+        fd_ = open(path.c_str(), flags | O_CLOEXEC, 0644);
+        if (fd_ < 0) {
+            throw std::system_error(errno, std::generic_category(), "open " + path);
+        }
+        struct stat info;
+        if (fstat(fd_, &info) != 0) {
+            int error = errno;
+            close(fd_);
+            throw std::system_error(error, std::generic_category(), "fstat " + path);
+        }
+        size_t bytes = static_cast<size_t>(info.st_size);
+        if (bytes % sizeof(Type) != 0) {
+            close(fd_);
+            throw std::runtime_error(path + " does not hold a whole number of elements");
+        }
+        try {
+            Map(bytes / sizeof(Type));
+        } catch (...) {
+            close(fd_);
+            throw;
+        }
+        size_ = capacity_;
+    }
+
+    MmapVector(const MmapVector&) = delete;
+    MmapVector& operator=(const MmapVector&) = delete;
+
+    MmapVector(MmapVector&& other) noexcept
+    : mode_(other.mode_)
+    , fd_(std::exchange(other.fd_, -1))
+    , data_(std::exchange(other.data_, nullptr))
+    , size_(std::exchange(other.size_, 0))
+    , capacity_(std::exchange(other.capacity_, 0))
+    {
+    }
+
+    MmapVector& operator=(MmapVector&& rhs) noexcept {
+        if (this != &rhs) {
+            MmapVector moved(std::move(rhs));
+            swap(moved);
+        }
+        return *this;
+    }
+
+    // Снимает отображение и обрезает файл до фактического размера; ошибки здесь уже некому сообщить
+    ~MmapVector() {
+        if (fd_ < 0) {
+            return;
+        }
+        Unmap();
+        if (mode_ == MapMode::READ_WRITE) {
+            [[maybe_unused]] int result = ftruncate(fd_, static_cast<off_t>(size_ * sizeof(Type)));
+        }
+        close(fd_);
+    }
+
+    void swap(MmapVector& other) noexcept {
+        std::swap(mode_, other.mode_);
+        std::swap(fd_, other.fd_);
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+    }
+
+    // Сбрасывает изменённые страницы [0, GetSize()) на диск и ждёт завершения записи
+    void Sync() {
+        if (mode_ == MapMode::READ_ONLY || size_ == 0) {
+            return;
+        }
+        if (msync(data_, size_ * sizeof(Type), MS_SYNC) != 0) {
+            throw std::system_error(errno, std::generic_category(), "msync");
+        }
+    }
+
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > capacity_) {
+            Remap(new_capacity);
+        }
+    }
+
+    void ShrinkToFit() {
+        if (capacity_ > size_) {
+            Remap(size_);
+        }
+    }
+
+    // Копия снимается до роста: value может ссылаться на элемент, который mremap перенесёт
+    void PushBack(const Type& value) {
+        RequireWritable();
+        Type copy = value;
+        if (size_ == capacity_) {
+            Remap(GrowCapacity(size_ + 1));
+        }
+        data_[size_++] = copy;
+    }
+
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        PushBack(Type(std::forward<Args>(args)...));
+        return data_[size_ - 1];
+    }
+
+    template <typename InputIt>
+    void AppendRange(InputIt first, InputIt last) {
+        RequireWritable();
+        using Category = typename std::iterator_traits<InputIt>::iterator_category;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>) {
+            size_t count = std::distance(first, last);
+            if (count > capacity_ - size_) {
+                Remap(GrowCapacity(size_ + count));
+            }
+            std::copy(first, last, end());
+            size_ += count;
+        } else {
+            for (; first != last; ++first) {
+                PushBack(*first);
+            }
+        }
+    }
+
+    Iterator Insert(ConstIterator pos, const Type& value) {
+        assert(pos >= begin() && pos <= end());
+        RequireWritable();
+        size_t index = pos - begin();
+        Type copy = value;
+        if (size_ == capacity_) {
+            Remap(GrowCapacity(size_ + 1));
+        }
+        std::memmove(data_ + index + 1, data_ + index, (size_ - index) * sizeof(Type));
+        data_[index] = copy;
+        ++size_;
+        return begin() + index;
+    }
+
+    Iterator Erase(ConstIterator pos) {
+        assert(pos >= begin() && pos < end());
+        return Erase(pos, pos + 1);
+    }
+
+    Iterator Erase(ConstIterator first, ConstIterator last) {
+        assert(first >= begin() && first <= last && last <= end());
+        RequireWritable();
+        Iterator from = begin() + (first - begin());
+        std::memmove(from, last, (cend() - last) * sizeof(Type));
+        size_ -= last - first;
+        return from;
+    }
+
+    void PopBack() noexcept {
+        assert(size_ != 0 && mode_ == MapMode::READ_WRITE);
+        --size_;
+    }
+
+    void Clear() {
+        RequireWritable();
+        size_ = 0;
+    }
+
+    // Новые элементы получают значение по умолчанию; в пределах вместимости отображение не меняется
+    void Resize(size_t new_size) {
+        RequireWritable();
+        if (new_size > capacity_) {
+            Remap(GrowCapacity(new_size));
+        }
+        if (new_size > size_) {
+            std::fill(data_ + size_, data_ + new_size, Type{});
+        }
+        size_ = new_size;
+    }
+
+    MapMode GetMode() const noexcept {
+        return mode_;
+    }
+
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    size_t GetCapacity() const noexcept {
+        return capacity_;
+    }
+
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    // В режиме READ_ONLY страницы отображены только на чтение: запись через ссылку завершит процесс
+    Type& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return data_[index];
+    }
+
+    const Type& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return data_[index];
+    }
+
+    Type& At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("out_of_range");
+        }
+        return data_[index];
+    }
+
+    const Type& At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("out_of_range");
+        }
+        return data_[index];
+    }
+
+    Iterator begin() noexcept {
+        return data_;
+    }
+
+    Iterator end() noexcept {
+        return data_ + size_;
+    }
+
+    ConstIterator begin() const noexcept {
+        return data_;
+    }
+
+    ConstIterator end() const noexcept {
+        return data_ + size_;
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return data_;
+    }
+
+    ConstIterator cend() const noexcept {
+        return data_ + size_;
+    }
+
+private:
+    void RequireWritable() const {
+        if (mode_ == MapMode::READ_ONLY) {
+            throw std::logic_error("MmapVector is opened read-only");
+        }
+    }
+
+    // Не меньше страницы за раз, чтобы мелкие типы не дёргали ftruncate на каждый элемент
+    size_t GrowCapacity(size_t required) const {
+        size_t page_elements = static_cast<size_t>(sysconf(_SC_PAGESIZE)) / sizeof(Type);
+        return std::max({required, page_elements, GrowthPolicy::Grow(capacity_)});
+    }
+
+    // Отображает первые capacity элементов файла
+    void Map(size_t capacity) {
+        if (capacity != 0) {
+            int protection = mode_ == MapMode::READ_ONLY ? PROT_READ : PROT_READ | PROT_WRITE;
+            void* mapped = mmap(nullptr, capacity * sizeof(Type), protection, MAP_SHARED, fd_, 0);
+            if (mapped == MAP_FAILED) {
+                throw std::system_error(errno, std::generic_category(), "mmap");
+            }
+            data_ = static_cast<Type*>(mapped);
+        }
+        capacity_ = capacity;
+    }
+
+    void Unmap() noexcept {
+        if (data_ != nullptr) {
+            munmap(data_, capacity_ * sizeof(Type));
+            data_ = nullptr;
+        }
+        capacity_ = 0;
+    }
+
+    // Меняет длину файла и отображения. При росте файл удлиняется до mremap, иначе обращение
+    // к новым страницам дало бы SIGBUS; при уменьшении - наоборот
+    void Remap(size_t new_capacity) {
+        RequireWritable();
+        size_t old_capacity = capacity_;
+        size_t new_bytes = new_capacity * sizeof(Type);
+        if (new_capacity > capacity_ && ftruncate(fd_, static_cast<off_t>(new_bytes)) != 0) {
+            throw std::system_error(errno, std::generic_category(), "ftruncate");
+        }
+        if (data_ == nullptr || new_capacity == 0) {
+            Unmap();
+            Map(new_capacity);
+        } else {
+#ifdef __linux__
+            void* mapped = mremap(data_, capacity_ * sizeof(Type), new_bytes, MREMAP_MAYMOVE);
+            if (mapped == MAP_FAILED) {
+                throw std::system_error(errno, std::generic_category(), "mremap");
+            }
+            data_ = static_cast<Type*>(mapped);
+            capacity_ = new_capacity;
+#else
+            // Без mremap отображение пересоздаётся: данные всё равно в файле, копировать нечего
+            Unmap();
+            Map(new_capacity);
+#endif
+        }
+        if (new_capacity < old_capacity && ftruncate(fd_, static_cast<off_t>(new_bytes)) != 0) {
+            throw std::system_error(errno, std::generic_category(), "ftruncate");
+        }
+    }
+
+    MapMode mode_;
+    int fd_ = -1;
+    Type* data_ = nullptr;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+};
@@ -0,0 +1,198 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Пул потоков для массовых операций над огромными массивами.
+// Вызывающий поток тоже берёт задачи, поэтому пул из N рабочих даёт N + 1 исполнителя
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t workers) {
+        workers_.reserve(workers);
+        for (size_t i = 0; i < workers; ++i) {
+            workers_.emplace_back([this] {
+                WorkerLoop();
+            });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (std::thread& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    size_t GetThreadCount() const noexcept {
+        return workers_.size() + 1;
+    }
+
+    // Выполняет task(index) для всех index из [0, tasks) и возвращает управление, когда все задачи завершены.
+    // Исключения task должна перехватывать сама. Вызов из задачи любого пула и вызов, пока пул занят
+    // другим потоком, выполняют задачи в вызывающем потоке - вложенные и одновременные вызовы
+    // не ждут друг друга
+    void RunTasks(size_t tasks, const std::function<void(size_t)>& task) {
+        std::unique_lock<std::mutex> run_lock;
+        if (!inside_pool_ && !workers_.empty()) {
+            run_lock = std::unique_lock(run_mutex_, std::try_to_lock);
+        }
+        if (!run_lock.owns_lock()) {
+            for (size_t index = 0; index < tasks; ++index) {
+                task(index);
+            }
+            return;
+        }
+        {
+            std::lock_guard lock(mutex_);
+            task_ = &task;
+            tasks_ = tasks;
+            next_.store(0, std::memory_order_relaxed);
+            busy_ = workers_.size();
+            ++generation_;
+        }
+        wake_.notify_all();
+        Drain();
+        std::unique_lock lock(mutex_);
+        done_.wait(lock, [this] {
+            return busy_ == 0;
+        });
+        task_ = nullptr;
+    }
+
+private:
+    // Вызывающий поток выполняет задачи, владея run_mutex_: повторный try_lock из вложенного вызова
+    // был бы неопределённым поведением, поэтому такие вызовы распознаются по флагу потока
+    void Drain() {
+        bool was_inside = std::exchange(inside_pool_, true);
+        for (size_t index = next_.fetch_add(1); index < tasks_; index = next_.fetch_add(1)) {
+            (*task_)(index);
+        }
+        inside_pool_ = was_inside;
+    }
+
+    void WorkerLoop() {
+        size_t seen = 0;
+        std::unique_lock lock(mutex_);
+        while (true) {
+            wake_.wait(lock, [&] {
+                return stop_ || generation_ != seen;
+            });
+            if (stop_) {
+                return;
+            }
+            seen = generation_;
+            lock.unlock();
+            Drain();
+            lock.lock();
+            if (--busy_ == 0) {
+                done_.notify_one();
+            }
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::mutex run_mutex_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    const std::function<void(size_t)>* task_ = nullptr;
+    size_t tasks_ = 0;
+    std::atomic<size_t> next_ = 0;
+    size_t busy_ = 0;
+    size_t generation_ = 0;
+    bool stop_ = false;
+    static inline thread_local bool inside_pool_ = false;
+};
+
+// Массивы побайтово копируемых типов от этого размера в байтах создаются, копируются и переносятся параллельно
+inline std::atomic<size_t>& ParallelThresholdBytes() noexcept {
+    static std::atomic<size_t> threshold = size_t(64) * 1024 * 1024;
+    return threshold;
+}
+
+// Порог для остальных типов. Их конструкторы могут трогать общее состояние (счётчики, журналы,
+// аллокаторы), поэтому по умолчанию такие массивы создаются последовательно
+inline std::atomic<size_t>& ParallelNonTrivialThresholdBytes() noexcept {
+    static std::atomic<size_t> threshold = SIZE_MAX;
+    return threshold;
+}
+
+// 0 - параллельный режим выключен
+inline void SetParallelThreshold(size_t bytes) noexcept {
+    ParallelThresholdBytes().store(bytes == 0 ? SIZE_MAX : bytes, std::memory_order_relaxed);
+}
+
+// Включает параллельный режим для типов, не копируемых побайтово; 0 - выключает.
+// Конструкторы этих типов должны допускать одновременный вызов для разных объектов
+inline void SetParallelNonTrivialThreshold(size_t bytes) noexcept {
+    ParallelNonTrivialThresholdBytes().store(bytes == 0 ? SIZE_MAX : bytes, std::memory_order_relaxed);
+}
+
+inline ThreadPool& GetParallelPool() {
+    static ThreadPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+    return pool;
+}
+
+// Создаёт элементы to[0, count), вызывая construct(begin, end) для непрерывных кусков массива.
+// construct создаёт либо весь кусок, либо ничего (как std::uninitialized_*). Большие массивы делятся
+// между потоками пула: каждый поток первым касается страниц своего куска, и ядро размещает их
+// на узле NUMA этого потока. Если какой-то кусок бросил исключение, созданные куски разрушаются,
+// а первое исключение пробрасывается дальше - как и у последовательного std::uninitialized_copy.
+// Порог зависит от того, копируется ли Type побайтово (см. SetParallelNonTrivialThreshold)
+template <typename Type, typename Construct>
+void ConstructInChunks(Type* to, size_t count, Construct construct) {
+    // Кусок не меньше 4 МиБ, чтобы накладные расходы на задачу терялись на фоне работы
+    constexpr size_t MIN_CHUNK_BYTES = 4 * 1024 * 1024;
+    size_t bytes = count * sizeof(Type);
+    const std::atomic<size_t>& threshold =
+        std::is_trivially_copyable_v<Type> ? ParallelThresholdBytes() : ParallelNonTrivialThresholdBytes();
+    if (bytes < threshold.load(std::memory_order_relaxed)) {
+        construct(size_t(0), count);
+        return;
+    }
+    ThreadPool& pool = GetParallelPool();
+    size_t chunk = std::max(MIN_CHUNK_BYTES / sizeof(Type), count / (pool.GetThreadCount() * 4) + 1);
+    size_t chunks = (count + chunk - 1) / chunk;
+    std::unique_ptr<std::exception_ptr[]> errors(new std::exception_ptr[chunks]);
+    pool.RunTasks(chunks, [&](size_t index) {
+        try {
+            construct(index * chunk, std::min(count, (index + 1) * chunk));
+        } catch (...) {
+            errors[index] = std::current_exception();
+        }
+    });
+    std::exception_ptr first_error;
+    for (size_t index = 0; index < chunks; ++index) {
+        if (errors[index] && !first_error) {
+            first_error = errors[index];
+        }
+    }
+    if (first_error) {
+        if constexpr (!std::is_trivially_destructible_v<Type>) {
+            for (size_t index = 0; index < chunks; ++index) {
+                if (!errors[index]) {
+                    std::destroy(to + index * chunk, to + std::min(count, (index + 1) * chunk));
+                }
+            }
+        }
+        std::rethrow_exception(first_error);
+    }
+}
@@ -0,0 +1,403 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include "simple_vector.h"
+
+// Сдвиг, при котором кусок занимает около 64 КиБ, но не меньше одного элемента
+template <typename Type>
+constexpr size_t DefaultChunkShift() noexcept {
+    size_t shift = 0;
+    while (shift < 16 && (size_t(2) << shift) * sizeof(Type) <= 64 * 1024) {
+        ++shift;
+    }
+    return shift;
+}
+
+// Вектор из кусков по 2^ChunkShift элементов, адреса которых хранятся в небольшом оглавлении.
+// При росте выделяется только новый кусок, а существующие элементы никуда не переезжают:
+// ссылки и указатели на них остаются действительными, пока элемент не удалён, а пик памяти
+// при росте - размер данных плюс один кусок вместо трёхкратного у SimpleVector.
+// Индекс переводится в кусок и смещение сдвигом и маской, так что доступ остаётся O(1).
+// Вставка и удаление в середине сдвигают элементы после позиции, как и у SimpleVector
+template <typename Type, size_t ChunkShift = DefaultChunkShift<Type>()>
+class SegmentedVector {
+    using ChunkAllocator = std::allocator<Type>;
+    using ChunkTraits = std::allocator_traits<ChunkAllocator>;
+
+public:
+    static constexpr size_t CHUNK_SIZE = size_t(1) << ChunkShift;
+
+    template <bool IsConst>
+    class BasicIterator;
+
+    using Iterator = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+
+    SegmentedVector() noexcept = default;
+
+    // Конструкторы ниже делегируют конструктору по умолчанию: если заполнение бросит исключение,
+    // деструктор разрушит созданные элементы и освободит куски
+    explicit SegmentedVector(size_t size)
+    : SegmentedVector()
+    {
+        Resize(size);
+    }
+
+    SegmentedVector(size_t size, const Type& value)
+    : SegmentedVector()
+    {
+        Reserve(size);
+        while (size_ < size) {
+            EmplaceBack(value);
+        }
+    }
+
+    SegmentedVector(std::initializer_list<Type> init)
+    : SegmentedVector()
+    {
+        Reserve(init.size());
+        for (const Type& value : init) {
+            EmplaceBack(value);
+        }
+    }
+
+    SegmentedVector(const SegmentedVector& other)
+    : SegmentedVector()
+    {
+        Reserve(other.size_);
+        for (const Type& value : other) {
+            EmplaceBack(value);
+        }
+    }
+
+    SegmentedVector(SegmentedVector&& other) noexcept {
+        swap(other);
+    }
+
+    SegmentedVector& operator=(const SegmentedVector& rhs) {
+        if (this != &rhs) {
+            SegmentedVector copy(rhs);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    SegmentedVector& operator=(SegmentedVector&& rhs) noexcept {
+        if (this != &rhs) {
+            SegmentedVector moved(std::move(rhs));
+            swap(moved);
+        }
+        return *this;
+    }
+
+    ~SegmentedVector() {
+        Clear();
+        ReleaseChunks(0);
+    }
+
+    void swap(SegmentedVector& other) noexcept {
+        chunks_.swap(other.chunks_);
+        std::swap(size_, other.size_);
+    }
+
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    size_t GetCapacity() const noexcept {
+        return chunks_.GetSize() * CHUNK_SIZE;
+    }
+
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    // Выделяет куски заранее; уже созданные элементы не переносятся
+    void Reserve(size_t new_capacity) {
+        size_t chunks = (new_capacity + CHUNK_SIZE - 1) >> ChunkShift;
+        chunks_.Reserve(chunks);
+        while (chunks_.GetSize() < chunks) {
+            AddChunk();
+        }
+    }
+
+    // Освобождает куски, в которых не осталось элементов
+    void ShrinkToFit() {
+        ReleaseChunks((size_ + CHUNK_SIZE - 1) >> ChunkShift);
+        chunks_.ShrinkToFit();
+    }
+
+    void PushBack(const Type& item) {
+        EmplaceBack(item);
+    }
+
+    void PushBack(Type&& item) {
+        EmplaceBack(std::move(item));
+    }
+
+    // Если нужен новый кусок, старые элементы остаются на месте, поэтому аргументы
+    // могут ссылаться на элементы самого вектора
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        if (size_ == GetCapacity()) {
+            AddChunk();
+        }
+        Type* slot = Slot(size_);
+        new (slot) Type(std::forward<Args>(args)...);
+        ++size_;
+        return *slot;
+    }
+
+    void PopBack() noexcept {
+        assert(size_ != 0);
+        std::destroy_at(Slot(size_ - 1));
+        --size_;
+    }
+
+    Iterator Insert(ConstIterator pos, const Type& value) {
+        size_t index = pos - cbegin();
+        EmplaceBack(value);
+        std::rotate(begin() + index, end() - 1, end());
+        return begin() + index;
+    }
+
+    Iterator Insert(ConstIterator pos, Type&& value) {
+        size_t index = pos - cbegin();
+        EmplaceBack(std::move(value));
+        std::rotate(begin() + index, end() - 1, end());
+        return begin() + index;
+    }
+
+    Iterator Erase(ConstIterator pos) {
+        assert(pos >= cbegin() && pos < cend());
+        size_t index = pos - cbegin();
+        std::move(begin() + index + 1, end(), begin() + index);
+        PopBack();
+        return begin() + index;
+    }
+
+    // Разрушает элементы, куски остаются для повторного заполнения
+    void Clear() noexcept {
+        while (size_ != 0) {
+            PopBack();
+        }
+    }
+
+    void Resize(size_t new_size) {
+        while (size_ > new_size) {
+            PopBack();
+        }
+        Reserve(new_size);
+        while (size_ < new_size) {
+            EmplaceBack();
+        }
+    }
+
+    Type& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return *Slot(index);
+    }
+
+    const Type& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return *Slot(index);
+    }
+
+    Type& At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("out_of_range");
+        }
+        return *Slot(index);
+    }
+
+    const Type& At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("out_of_range");
+        }
+        return *Slot(index);
+    }
+
+    Iterator begin() noexcept {
+        return {chunks_.begin(), 0};
+    }
+
+    Iterator end() noexcept {
+        return {chunks_.begin(), size_};
+    }
+
+    ConstIterator begin() const noexcept {
+        return {chunks_.begin(), 0};
+    }
+
+    ConstIterator end() const noexcept {
+        return {chunks_.begin(), size_};
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+    // Итератор произвольного доступа: оглавление кусков и индекс элемента.
+    // Как и у SimpleVector, действителен до изменения размера оглавления
+    template <bool IsConst>
+    class BasicIterator {
+        using Chunk = std::conditional_t<IsConst, Type* const, Type*>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = Type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const Type*, Type*>;
+        using reference = std::conditional_t<IsConst, const Type&, Type&>;
+
+        BasicIterator() noexcept = default;
+
+        BasicIterator(Chunk* chunks, size_t index) noexcept
+        : chunks_(chunks), index_(index)
+        {
+        }
+
+        // Неконстантный итератор приводится к константному
+        operator BasicIterator<true>() const noexcept {
+            return {chunks_, index_};
+        }
+
+        reference operator*() const noexcept {
+            return chunks_[index_ >> ChunkShift][index_ & (CHUNK_SIZE - 1)];
+        }
+
+        pointer operator->() const noexcept {
+            return &**this;
+        }
+
+        reference operator[](difference_type offset) const noexcept {
+            return *(*this + offset);
+        }
+
+        BasicIterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            BasicIterator old = *this;
+            ++index_;
+            return old;
+        }
+
+        BasicIterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+
+        BasicIterator operator--(int) noexcept {
+            BasicIterator old = *this;
+            --index_;
+            return old;
+        }
+
+        BasicIterator& operator+=(difference_type offset) noexcept {
+            index_ += offset;
+            return *this;
+        }
+
+        BasicIterator& operator-=(difference_type offset) noexcept {
+            index_ -= offset;
+            return *this;
+        }
+
+        friend BasicIterator operator+(BasicIterator it, difference_type offset) noexcept {
+            return it += offset;
+        }
+
+        friend BasicIterator operator+(difference_type offset, BasicIterator it) noexcept {
+            return it += offset;
+        }
+
+        friend BasicIterator operator-(BasicIterator it, difference_type offset) noexcept {
+            return it -= offset;
+        }
+
+        friend difference_type operator-(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ != rhs.index_;
+        }
+
+        friend bool operator<(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ < rhs.index_;
+        }
+
+        friend bool operator>(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return rhs < lhs;
+        }
+
+        friend bool operator<=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return !(rhs < lhs);
+        }
+
+        friend bool operator>=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return !(lhs < rhs);
+        }
+
+    private:
+        Chunk* chunks_ = nullptr;
+        size_t index_ = 0;
+    };
+
+private:
+    Type* Slot(size_t index) const noexcept {
+        return chunks_[index >> ChunkShift] + (index & (CHUNK_SIZE - 1));
+    }
+
+    void AddChunk() {
+        ChunkAllocator alloc;
+        Type* chunk = ChunkTraits::allocate(alloc, CHUNK_SIZE);
+        try {
+            chunks_.PushBack(chunk);
+        } catch (...) {
+            ChunkTraits::deallocate(alloc, chunk, CHUNK_SIZE);
+            throw;
+        }
+    }
+
+    // Освобождает куски начиная с first; элементы в них уже разрушены
+    void ReleaseChunks(size_t first) noexcept {
+        ChunkAllocator alloc;
+        while (chunks_.GetSize() > first) {
+            ChunkTraits::deallocate(alloc, chunks_[chunks_.GetSize() - 1], CHUNK_SIZE);
+            chunks_.PopBack();
+        }
+    }
+
+    // Оглавление: указатели на куски. Перевыделяется редко и переносит только указатели
+    SimpleVector<Type*> chunks_;
+    size_t size_ = 0;
+};
+
+template <typename Type, size_t ChunkShift>
+bool operator==(const SegmentedVector<Type, ChunkShift>& lhs, const SegmentedVector<Type, ChunkShift>& rhs) {
+    return lhs.GetSize() == rhs.GetSize() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename Type, size_t ChunkShift>
+bool operator!=(const SegmentedVector<Type, ChunkShift>& lhs, const SegmentedVector<Type, ChunkShift>& rhs) {
+    return !(lhs == rhs);
+}
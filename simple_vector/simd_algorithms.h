@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cassert>
+#include <utility>
+#include "simd_kernels.h"
+#include "simple_vector.h"
+
+// Алгоритмы над SimpleVector арифметических типов на векторизованных ядрах из simd_kernels.h
+
+template <typename Type, typename Allocator, typename GrowthPolicy>
+Type Sum(const SimpleVector<Type, Allocator, GrowthPolicy>& v) {
+    static_assert(simd::IS_VECTORIZABLE<Type>, "Sum needs an arithmetic element type");
+    return simd::Sum(v.begin(), v.GetSize());
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy>
+Type Dot(const SimpleVector<Type, Allocator, GrowthPolicy>& lhs, const SimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
+    static_assert(simd::IS_VECTORIZABLE<Type>, "Dot needs an arithmetic element type");
+    assert(lhs.GetSize() == rhs.GetSize());
+    return simd::Dot(lhs.begin(), rhs.begin(), lhs.GetSize());
+}
+
+// Возвращает пару {минимум, максимум}. Вектор не должен быть пустым
+template <typename Type, typename Allocator, typename GrowthPolicy>
+std::pair<Type, Type> MinMax(const SimpleVector<Type, Allocator, GrowthPolicy>& v) {
+    static_assert(simd::IS_VECTORIZABLE<Type>, "MinMax needs an arithmetic element type");
+    assert(!v.IsEmpty());
+    return simd::MinMax(v.begin(), v.GetSize());
+}
+
+// Возвращает итератор на первый элемент, равный value, или end()
+template <typename Type, typename Allocator, typename GrowthPolicy>
+typename SimpleVector<Type, Allocator, GrowthPolicy>::ConstIterator Find(const SimpleVector<Type, Allocator, GrowthPolicy>& v, Type value) {
+    static_assert(simd::IS_VECTORIZABLE<Type>, "Find needs an arithmetic element type");
+    return v.begin() + simd::Find(v.begin(), v.GetSize(), value);
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy>
+size_t Count(const SimpleVector<Type, Allocator, GrowthPolicy>& v, Type value) {
+    static_assert(simd::IS_VECTORIZABLE<Type>, "Count needs an arithmetic element type");
+    return simd::Count(v.begin(), v.GetSize(), value);
+}
+
+// Поэлементно прибавляет src к dst. Размеры должны совпадать
+template <typename Type, typename Allocator, typename GrowthPolicy>
+void Add(SimpleVector<Type, Allocator, GrowthPolicy>& dst, const SimpleVector<Type, Allocator, GrowthPolicy>& src) {
+    static_assert(simd::IS_VECTORIZABLE<Type>, "Add needs an arithmetic element type");
+    assert(dst.GetSize() == src.GetSize());
+    simd::Add(dst.begin(), src.begin(), dst.GetSize());
+}
+
+// Умножает каждый элемент на factor
+template <typename Type, typename Allocator, typename GrowthPolicy>
+void Scale(SimpleVector<Type, Allocator, GrowthPolicy>& v, Type factor) {
+    static_assert(simd::IS_VECTORIZABLE<Type>, "Scale needs an arithmetic element type");
+    simd::Scale(v.begin(), v.GetSize(), factor);
+}
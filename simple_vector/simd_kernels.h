@@ -0,0 +1,175 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+// Векторизованные ядра для массивов арифметических типов.
+// Каждое ядро написано один раз на векторных расширениях GCC/Clang с шириной вектора VECTOR_BYTES
+// и собирается в нескольких вариантах: AVX-512, AVX2, SSE2 (базовый для x86-64) и скалярном (VECTOR_BYTES == 0).
+// Вариант выбирается во время выполнения по возможностям процессора
+namespace simd {
+
+enum class Level {
+    SCALAR,
+    SSE2,
+    AVX2,
+    AVX512,
+};
+
+inline Level DetectLevel() noexcept {
+#if defined(__GNUC__) && defined(__x86_64__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")
+        && __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512vl")) {
+        return Level::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return Level::AVX2;
+    }
+    return Level::SSE2;
+#else
+    return Level::SCALAR;
+#endif
+}
+
+inline Level& ActiveLevel() noexcept {
+    static Level level = DetectLevel();
+    return level;
+}
+
+inline Level GetLevel() noexcept {
+    return ActiveLevel();
+}
+
+// Ограничивает используемый набор инструкций, например, чтобы сравнить варианты между собой.
+// Поднять уровень выше поддерживаемого процессором нельзя
+inline void SetLevel(Level level) noexcept {
+    ActiveLevel() = std::min(level, DetectLevel());
+}
+
+// bool и long double векторные расширения не поддерживают
+template <typename Type>
+inline constexpr bool IS_VECTORIZABLE = std::is_arithmetic_v<Type> && !std::is_same_v<Type, bool>
+                                        && !std::is_same_v<Type, long double>;
+
+// Ядра из simd_kernels_impl.h компилируются в отдельном пространстве имён на каждый вариант.
+// Варианты AVX2 и AVX-512 целиком лежат в областях #pragma GCC target: атрибут target на обёртке
+// не помогает, если ядра встраиваются в неё, - сравнения 512-битных векторов тогда разворачиваются в скалярный код
+namespace scalar {
+constexpr size_t VECTOR_BYTES = 0;
+#include "simd_kernels_impl.h"
+}  // namespace scalar
+
+namespace sse2 {
+constexpr size_t VECTOR_BYTES = 16;
+#include "simd_kernels_impl.h"
+}  // namespace sse2
+
+#if defined(__x86_64__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+namespace avx2 {
+constexpr size_t VECTOR_BYTES = 32;
+#include "simd_kernels_impl.h"
+}  // namespace avx2
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx512f,avx512bw,avx512dq,avx512vl")
+namespace avx512 {
+constexpr size_t VECTOR_BYTES = 64;
+#include "simd_kernels_impl.h"
+}  // namespace avx512
+#pragma GCC pop_options
+
+#define SIMD_DISPATCH(KERNEL, ...)            \
+    switch (GetLevel()) {                     \
+    case Level::AVX512:                       \
+        return avx512::KERNEL(__VA_ARGS__);   \
+    case Level::AVX2:                         \
+        return avx2::KERNEL(__VA_ARGS__);     \
+    case Level::SSE2:                         \
+        return sse2::KERNEL(__VA_ARGS__);     \
+    default:                                  \
+        return scalar::KERNEL(__VA_ARGS__);   \
+    }
+#else
+#define SIMD_DISPATCH(KERNEL, ...) return scalar::KERNEL(__VA_ARGS__);
+#endif
+
+// Порядок сложения отличается от последовательного, поэтому для float/double результат может
+// отличаться от простого цикла в младших разрядах
+template <typename Type>
+Type Sum(const Type* data, size_t size) {
+    SIMD_DISPATCH(Sum, data, size)
+}
+
+template <typename Type>
+Type Dot(const Type* lhs, const Type* rhs, size_t size) {
+    SIMD_DISPATCH(Dot, lhs, rhs, size)
+}
+
+// Массив не должен быть пустым
+template <typename Type>
+std::pair<Type, Type> MinMax(const Type* data, size_t size) {
+    SIMD_DISPATCH(MinMax, data, size)
+}
+
+template <typename Type>
+size_t Find(const Type* data, size_t size, Type value) {
+    SIMD_DISPATCH(Find, data, size, value)
+}
+
+template <typename Type>
+size_t Count(const Type* data, size_t size, Type value) {
+    SIMD_DISPATCH(Count, data, size, value)
+}
+
+template <typename Type>
+void Add(Type* dst, const Type* src, size_t size) {
+    SIMD_DISPATCH(Add, dst, src, size)
+}
+
+template <typename Type>
+void Scale(Type* data, size_t size, Type factor) {
+    SIMD_DISPATCH(Scale, data, size, factor)
+}
+
+template <typename Type>
+size_t Mismatch(const Type* lhs, const Type* rhs, size_t size) {
+    SIMD_DISPATCH(Mismatch, lhs, rhs, size)
+}
+
+#undef SIMD_DISPATCH
+
+// То же, что std::equal: сравнение через ==, поэтому NaN не равен сам себе, а +0.0 равен -0.0
+template <typename Type>
+bool Equal(const Type* lhs, const Type* rhs, size_t size) {
+    return Mismatch(lhs, rhs, size) == size;
+}
+
+// То же, что std::lexicographical_compare: несравнимые элементы (NaN) пропускаются
+template <typename Type>
+bool LexicographicalLess(const Type* lhs, size_t lhs_size, const Type* rhs, size_t rhs_size) {
+    size_t common = std::min(lhs_size, rhs_size);
+    size_t i = 0;
+    while (true) {
+        i += Mismatch(lhs + i, rhs + i, common - i);
+        if (i == common) {
+            return lhs_size < rhs_size;
+        }
+        if (lhs[i] < rhs[i]) {
+            return true;
+        }
+        if (rhs[i] < lhs[i]) {
+            return false;
+        }
+        ++i;
+    }
+}
+
+}  // namespace simd
@@ -0,0 +1,239 @@
+// Без #pragma once: файл включается из simd_kernels.h несколько раз, в разные пространства имён,
+// каждое из которых перед включением объявляет VECTOR_BYTES - ширину вектора в байтах (0 - одна полоса).
+// Все заголовки стандартной библиотеки подключает simd_kernels.h
+
+template <typename Type, size_t Bytes = VECTOR_BYTES>
+struct VectorOf {
+    static constexpr size_t BYTES = Bytes == 0 ? sizeof(Type) : Bytes;
+    static constexpr size_t LANES = BYTES / sizeof(Type);
+    typedef Type Vector __attribute__((vector_size(BYTES)));
+};
+
+// Есть ли в маске сравнения хотя бы одна ненулевая полоса. Маска просматривается 64-битными словами
+template <typename Mask>
+inline bool AnyLane(const Mask& mask) {
+    if constexpr (sizeof(Mask) % sizeof(unsigned long long) == 0) {
+        constexpr size_t WORDS = sizeof(Mask) / sizeof(unsigned long long);
+        using Words = typename VectorOf<unsigned long long, sizeof(Mask)>::Vector;
+        // Приведение между векторами одного размера - побитовое, без обращения к памяти
+        Words words = (Words)mask;
+        unsigned long long any = 0;
+        for (size_t word = 0; word < WORDS; ++word) {
+            any |= words[word];
+        }
+        return any != 0;
+    } else {
+        bool any = false;
+        for (size_t lane = 0; lane < sizeof(Mask) / sizeof(mask[0]); ++lane) {
+            any |= mask[lane] != 0;
+        }
+        return any;
+    }
+}
+
+template <typename Type>
+Type Sum(const Type* data, size_t size) {
+    using V = typename VectorOf<Type>::Vector;
+    constexpr size_t LANES = VectorOf<Type>::LANES;
+    // Четыре независимых аккумулятора, чтобы сложения не ждали друг друга
+    V acc[4] = {};
+    size_t i = 0;
+    for (; i + 4 * LANES <= size; i += 4 * LANES) {
+        for (size_t k = 0; k < 4; ++k) {
+            V x;
+            std::memcpy(&x, data + i + k * LANES, sizeof(x));
+            acc[k] += x;
+        }
+    }
+    for (; i + LANES <= size; i += LANES) {
+        V x;
+        std::memcpy(&x, data + i, sizeof(x));
+        acc[0] += x;
+    }
+    V total = (acc[0] + acc[1]) + (acc[2] + acc[3]);
+    Type result{};
+    for (size_t lane = 0; lane < LANES; ++lane) {
+        result += total[lane];
+    }
+    for (; i < size; ++i) {
+        result += data[i];
+    }
+    return result;
+}
+
+template <typename Type>
+Type Dot(const Type* lhs, const Type* rhs, size_t size) {
+    using V = typename VectorOf<Type>::Vector;
+    constexpr size_t LANES = VectorOf<Type>::LANES;
+    V acc[4] = {};
+    size_t i = 0;
+    for (; i + 4 * LANES <= size; i += 4 * LANES) {
+        for (size_t k = 0; k < 4; ++k) {
+            V x, y;
+            std::memcpy(&x, lhs + i + k * LANES, sizeof(x));
+            std::memcpy(&y, rhs + i + k * LANES, sizeof(y));
+            acc[k] += x * y;
+        }
+    }
+    for (; i + LANES <= size; i += LANES) {
+        V x, y;
+        std::memcpy(&x, lhs + i, sizeof(x));
+        std::memcpy(&y, rhs + i, sizeof(y));
+        acc[0] += x * y;
+    }
+    V total = (acc[0] + acc[1]) + (acc[2] + acc[3]);
+    Type result{};
+    for (size_t lane = 0; lane < LANES; ++lane) {
+        result += total[lane];
+    }
+    for (; i < size; ++i) {
+        result += lhs[i] * rhs[i];
+    }
+    return result;
+}
+
+template <typename Type>
+std::pair<Type, Type> MinMax(const Type* data, size_t size) {
+    using V = typename VectorOf<Type>::Vector;
+    constexpr size_t LANES = VectorOf<Type>::LANES;
+    Type min = data[0];
+    Type max = data[0];
+    size_t i = 0;
+    if (size >= LANES) {
+        V lo, hi;
+        std::memcpy(&lo, data, sizeof(lo));
+        hi = lo;
+        for (i = LANES; i + LANES <= size; i += LANES) {
+            V x;
+            std::memcpy(&x, data + i, sizeof(x));
+            lo = x < lo ? x : lo;
+            hi = x > hi ? x : hi;
+        }
+        for (size_t lane = 0; lane < LANES; ++lane) {
+            min = std::min<Type>(min, lo[lane]);
+            max = std::max<Type>(max, hi[lane]);
+        }
+    }
+    for (; i < size; ++i) {
+        min = std::min(min, data[i]);
+        max = std::max(max, data[i]);
+    }
+    return {min, max};
+}
+
+// Индекс первого элемента, равного value, или size
+template <typename Type>
+size_t Find(const Type* data, size_t size, Type value) {
+    using V = typename VectorOf<Type>::Vector;
+    constexpr size_t LANES = VectorOf<Type>::LANES;
+    V needle = V{} + value;
+    // Маски четырёх векторов объединяются и проверяются разом, точное место ищет хвостовой цикл
+    size_t i = 0;
+    for (; i + 4 * LANES <= size; i += 4 * LANES) {
+        V x0, x1, x2, x3;
+        std::memcpy(&x0, data + i, sizeof(x0));
+        std::memcpy(&x1, data + i + LANES, sizeof(x1));
+        std::memcpy(&x2, data + i + 2 * LANES, sizeof(x2));
+        std::memcpy(&x3, data + i + 3 * LANES, sizeof(x3));
+        if (AnyLane((x0 == needle) | (x1 == needle) | (x2 == needle) | (x3 == needle))) {
+            break;
+        }
+    }
+    for (; i < size; ++i) {
+        if (data[i] == value) {
+            return i;
+        }
+    }
+    return size;
+}
+
+template <typename Type>
+size_t Count(const Type* data, size_t size, Type value) {
+    using V = typename VectorOf<Type>::Vector;
+    constexpr size_t LANES = VectorOf<Type>::LANES;
+    V needle = V{} + value;
+    // Совпадение даёт в маске -1, поэтому счётчики уменьшаются; узкие счётчики сбрасываются до переполнения
+    using Mask = decltype(needle == needle);
+    using Lane = std::remove_reference_t<decltype(std::declval<Mask>()[0])>;
+    constexpr size_t FLUSH_EVERY = std::min<size_t>(std::numeric_limits<Lane>::max(), 1 << 20);
+    size_t result = 0;
+    size_t i = 0;
+    while (i + LANES <= size) {
+        Mask counters = {};
+        for (size_t step = 0; step < FLUSH_EVERY && i + LANES <= size; ++step, i += LANES) {
+            V x;
+            std::memcpy(&x, data + i, sizeof(x));
+            counters -= x == needle;
+        }
+        for (size_t lane = 0; lane < LANES; ++lane) {
+            result += static_cast<size_t>(counters[lane]);
+        }
+    }
+    for (; i < size; ++i) {
+        result += data[i] == value;
+    }
+    return result;
+}
+
+// Индекс первой позиции, где lhs[i] != rhs[i], или size
+template <typename Type>
+size_t Mismatch(const Type* lhs, const Type* rhs, size_t size) {
+    using V = typename VectorOf<Type>::Vector;
+    constexpr size_t LANES = VectorOf<Type>::LANES;
+    size_t i = 0;
+    for (; i + 4 * LANES <= size; i += 4 * LANES) {
+        V x0, x1, x2, x3, y0, y1, y2, y3;
+        std::memcpy(&x0, lhs + i, sizeof(x0));
+        std::memcpy(&x1, lhs + i + LANES, sizeof(x1));
+        std::memcpy(&x2, lhs + i + 2 * LANES, sizeof(x2));
+        std::memcpy(&x3, lhs + i + 3 * LANES, sizeof(x3));
+        std::memcpy(&y0, rhs + i, sizeof(y0));
+        std::memcpy(&y1, rhs + i + LANES, sizeof(y1));
+        std::memcpy(&y2, rhs + i + 2 * LANES, sizeof(y2));
+        std::memcpy(&y3, rhs + i + 3 * LANES, sizeof(y3));
+        if (AnyLane((x0 != y0) | (x1 != y1) | (x2 != y2) | (x3 != y3))) {
+            break;
+        }
+    }
+    for (; i < size; ++i) {
+        if (lhs[i] != rhs[i]) {
+            return i;
+        }
+    }
+    return size;
+}
+
+// dst[i] += src[i]
+template <typename Type>
+void Add(Type* dst, const Type* src, size_t size) {
+    using V = typename VectorOf<Type>::Vector;
+    constexpr size_t LANES = VectorOf<Type>::LANES;
+    size_t i = 0;
+    for (; i + LANES <= size; i += LANES) {
+        V x, y;
+        std::memcpy(&x, dst + i, sizeof(x));
+        std::memcpy(&y, src + i, sizeof(y));
+        x += y;
+        std::memcpy(dst + i, &x, sizeof(x));
+    }
+    for (; i < size; ++i) {
+        dst[i] += src[i];
+    }
+}
+
+// data[i] *= factor
+template <typename Type>
+void Scale(Type* data, size_t size, Type factor) {
+    using V = typename VectorOf<Type>::Vector;
+    constexpr size_t LANES = VectorOf<Type>::LANES;
+    size_t i = 0;
+    for (; i + LANES <= size; i += LANES) {
+        V x;
+        std::memcpy(&x, data + i, sizeof(x));
+        x *= factor;
+        std::memcpy(data + i, &x, sizeof(x));
+    }
+    for (; i < size; ++i) {
+        data[i] *= factor;
+    }
+}
@@ -5,8 +5,17 @@
 #include <initializer_list>
 #include <cstddef>
 #include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
 #include <stdexcept>
+#include <type_traits>
 #include "array_ptr.h"
+#include "instrumentation.h"
+#include "parallel_construct.h"
+#include "simd_kernels.h"
+#include "span.h"
 
 class ReserveProxyObj {
 public:
@@ -28,21 +37,123 @@ ReserveProxyObj Reserve(size_t capacity_to_reserve) {
     return ReserveProxyObj(capacity_to_reserve);
 }
 
+// Объекты типа можно переносить побайтовым копированием: копия, сделанная memcpy, полностью заменяет
+// исходный объект, и исходный после этого не разрушается. Верно для тривиально копируемых типов.
+// Для своих типов, которые не хранят указателей на самих себя (например, владеющих указателем на кучу),
+// шаблон можно специализировать значением true
 template <typename Type>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<Type> {
+};
+
+template <typename Type>
+inline constexpr bool IS_TRIVIALLY_RELOCATABLE = IsTriviallyRelocatable<Type>::value;
+
+// Создаёт в неинициализированной памяти to копии count элементов из from самым дешёвым корректным способом:
+// один memcpy для побайтово переносимых типов, перемещение, если оно не бросает исключений или копирование
+// невозможно, иначе копирование - тогда при исключении исходные элементы остаются нетронутыми.
+// Исходные элементы завершает DestroyTransferredElements, когда перенос всех частей удался.
+// Огромные массивы переносятся кусками в пуле потоков (см. ConstructInChunks)
+template <typename Type>
+void TransferElements(Type* from, size_t count, Type* to) {
+    if constexpr (IS_TRIVIALLY_RELOCATABLE<Type>) {
+        instrumentation::RecordTransfer(instrumentation::Transfer::RELOCATED, count);
+    } else if constexpr (std::is_nothrow_move_constructible_v<Type> || !std::is_copy_constructible_v<Type>) {
+        instrumentation::RecordTransfer(instrumentation::Transfer::MOVED, count);
+    } else {
+        instrumentation::RecordTransfer(instrumentation::Transfer::COPIED, count);
+    }
+    ConstructInChunks(to, count, [from, to](size_t first, size_t last) {
+        if constexpr (IS_TRIVIALLY_RELOCATABLE<Type>) {
+            if (first != last) {
+                std::memcpy(static_cast<void*>(to + first), static_cast<const void*>(from + first),
+                            (last - first) * sizeof(Type));
+            }
+        } else if constexpr (std::is_nothrow_move_constructible_v<Type> || !std::is_copy_constructible_v<Type>) {
+            std::uninitialized_move(from + first, from + last, to + first);
+        } else {
+            std::uninitialized_copy(from + first, from + last, to + first);
+        }
+    });
+}
+
+// Побайтово перенесённые объекты уже живут в новом буфере, старые копии не разрушаются
+template <typename Type>
+void DestroyTransferredElements(Type* from, size_t count) noexcept {
+    if constexpr (!IS_TRIVIALLY_RELOCATABLE<Type>) {
+        std::destroy_n(from, count);
+    }
+}
+
+// Политики роста вместимости. Grow(capacity) возвращает вместимость, до которой растёт заполненный буфер;
+// если её не хватает под вставку, вектор берёт ровно необходимую.
+// Геометрический рост с множителем Numerator / Denominator, не меньше чем на один элемент
+template <size_t Numerator, size_t Denominator = 1>
+struct GeometricGrowth {
+    static_assert(Numerator > Denominator, "capacity must grow");
+
+    static size_t Grow(size_t capacity) noexcept {
+        return std::max(capacity + 1, capacity + capacity / Denominator * (Numerator - Denominator));
+    }
+};
+
+using DoublingGrowth = GeometricGrowth<2>;
+
+// Меньший запас памяти ценой более частых перевыделений
+using OneAndHalfGrowth = GeometricGrowth<3, 2>;
+
+// Рост фиксированными порциями по ChunkSize элементов - для огромных буферов, где удвоение
+// означало бы гигабайты неиспользуемого запаса. Добавление в конец становится линейным по размеру,
+// поэтому ChunkSize стоит выбирать крупным
+template <size_t ChunkSize>
+struct ChunkGrowth {
+    static_assert(ChunkSize > 0, "chunk must not be empty");
+
+    static size_t Grow(size_t capacity) noexcept {
+        return capacity + ChunkSize;
+    }
+};
+
+// Память под элементы выделяет Allocator (например, std::pmr::polymorphic_allocator поверх арены),
+// сами элементы создаются в ней напрямую. Вместимость при нехватке места растёт по GrowthPolicy
+template <typename Type, typename Allocator = std::allocator<Type>, typename GrowthPolicy = DoublingGrowth>
 class SimpleVector {
+    using AllocatorTraits = std::allocator_traits<Allocator>;
+
+    // Отличает Insert(pos, first, last) от Insert(pos, count, value) при целочисленных аргументах
+    template <typename InputIt>
+    using RequireInputIterator = std::enable_if_t<std::is_base_of_v<std::input_iterator_tag,
+        typename std::iterator_traits<InputIt>::iterator_category>>;
+
 public:
     using Iterator = Type*;
     using ConstIterator = const Type*;
+    using AllocatorType = Allocator;
 
     constexpr SimpleVector() noexcept = default;
+
+    explicit SimpleVector(const Allocator& alloc) noexcept
+    : items_(alloc)
+    {
+    }
     
-    SimpleVector(SimpleVector&& other)
+    // Буфер забирается вместе с аллокатором, который его выделил
+    SimpleVector(SimpleVector&& other) noexcept
+    : items_(std::move(other.items_))
+    , size_(std::exchange(other.size_, 0))
+    , capacity_(std::exchange(other.capacity_, 0))
     {
-        non_copy_swap(std::move(other));
     }
     
     SimpleVector& operator=(SimpleVector&& rhs) {
-        swap(rhs);
+        if (GetAllocator() == rhs.GetAllocator()) {
+            swap(rhs);
+        } else {
+            // Буфер rhs выделен другим аллокатором и сюда не переезжает, поэтому элементы переносятся поштучно
+            SimpleVector moved(ReserveProxyObj(rhs.size_), GetAllocator());
+            std::uninitialized_move(rhs.begin(), rhs.end(), moved.begin());
+            moved.size_ = rhs.size_;
+            swap(moved);
+        }
         return *this;
     }
     
@@ -52,165 +163,229 @@ public:
         this->capacity_ = std::exchange(other.capacity_, this->capacity_);
     }
     
-    SimpleVector(const SimpleVector& other) {
-        SimpleVector<Type> tmp(other.size_);
-        std::copy(other.begin(), other.end(), &tmp[0]);
-        swap(tmp);
+    SimpleVector(const SimpleVector& other)
+    : SimpleVector(other, AllocatorTraits::select_on_container_copy_construction(other.GetAllocator()))
+    {
+    }
+
+    SimpleVector(const SimpleVector& other, const Allocator& alloc)
+    : items_(other.size_, alloc), capacity_(other.size_)
+    {
+        const Type* from = other.begin();
+        Type* to = begin();
+        ConstructInChunks(to, other.size_, [from, to](size_t first, size_t last) {
+            std::uninitialized_copy(from + first, from + last, to + first);
+        });
+        size_ = other.size_;
     }
     
-    
+    // Копия создаётся на аллокаторе этого вектора
     SimpleVector& operator=(const SimpleVector& rhs) {
         if (this != &rhs) {
-            auto rhscopy(rhs);
+            SimpleVector rhscopy(rhs, GetAllocator());
             swap(rhscopy);
         }
         return *this;
     }
     
-    explicit SimpleVector(size_t size)
-    : SimpleVector(size, Type())
+    explicit SimpleVector(size_t size, const Allocator& alloc = Allocator())
+    : items_(size, alloc), capacity_(size)
     {
+        ValueConstruct(begin(), size);
+        size_ = size;
     }
     
-    SimpleVector(size_t size, const Type& value)
-    : size_(size), capacity_(size) 
+    SimpleVector(size_t size, const Type& value, const Allocator& alloc = Allocator())
+    : items_(size, alloc), capacity_(size) 
     {
-        if(capacity_ != 0) {
-            ArrayPtr<Type> temp(size);
-            items_.swap(temp);
-        }
-        std::fill(begin(), end(), value);
+        Type* to = begin();
+        ConstructInChunks(to, size, [to, &value](size_t first, size_t last) {
+            std::uninitialized_fill(to + first, to + last, value);
+        });
+        size_ = size;
     }    
 
     // Создаёт вектор из std::initializer_list
-    SimpleVector(std::initializer_list<Type> init) 
-    : SimpleVector(init.size())
+    SimpleVector(std::initializer_list<Type> init, const Allocator& alloc = Allocator()) 
+    : items_(init.size(), alloc), capacity_(init.size())
     {
-        if(capacity_ != 0) {
-            std::copy(init.begin(), init.end(), begin());
-            size_ = capacity_;
-        }
+        std::uninitialized_copy(init.begin(), init.end(), begin());
+        size_ = init.size();
     }
     
-    explicit SimpleVector(ReserveProxyObj obj) {
-        ArrayPtr<Type> temp(obj.GetCapacity());
-        items_.swap(temp);
-        capacity_ = obj.GetCapacity();
+    explicit SimpleVector(ReserveProxyObj obj, const Allocator& alloc = Allocator())
+    : items_(obj.GetCapacity(), alloc), capacity_(obj.GetCapacity())
+    {
+    }
+
+    // Разрушает только созданные элементы [0, size_), память освобождает ArrayPtr
+    ~SimpleVector() {
+        std::destroy_n(begin(), size_);
     }
     
     void Reserve(size_t new_capacity) {
         if (new_capacity > capacity_) {
-            ArrayPtr<Type> tmp(new_capacity);
-            std::copy(begin(), end(), &tmp[0]);
-            items_.swap(tmp);
-            capacity_ = new_capacity;
+            Reallocate(new_capacity);
         }
     }
     
+    // Возвращает неиспользуемый запас памяти: элементы переезжают в буфер ровно под GetSize() элементов
+    void ShrinkToFit() {
+        if (capacity_ > size_) {
+            Reallocate(size_);
+        }
+    }
+
     void PushBack(const Type& item) {
-        if(size_ < capacity_) {
-            items_[size_] = item;
-            ++size_;
+        EmplaceBack(item);
+    }
+
+    void PushBack(Type&& item) {
+        EmplaceBack(std::move(item));
+    }
+
+    // Создаёт элемент в конце вектора прямо из аргументов конструктора Type.
+    // Аргументы могут ссылаться на элементы самого вектора: при росте новый элемент
+    // создаётся в новом буфере раньше, чем переносятся и разрушаются старые
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        if (size_ < capacity_) {
+            new (end()) Type(std::forward<Args>(args)...);
         } else {
-            ArrayPtr<Type> temp(std::max(size_t(1), capacity_ * 2));
-            if(capacity_ != 0) {
-                std::copy(begin(), end(), &temp[0]);
-                items_.swap(temp);
-                capacity_ *= 2;
-                items_[size_] = item;
-                ++size_;
-            } else {
-                temp[0] = item;
-                items_.swap(temp);
-                capacity_ = 1, size_ = 1;
-            }
+            EmplaceBackWithGrowth(std::forward<Args>(args)...);
         }
+        ++size_;
+        return *(end() - 1);
     }
 
-    void PushBack(Type&& item) {
-        if(size_ < capacity_) {
-            items_[size_] = std::move(item);
+    // Создаёт элемент перед pos из аргументов конструктора Type и возвращает итератор на него.
+    // Без роста элемент сначала создаётся во временном объекте, так как сдвиг хвоста может
+    // изменить элемент, на который ссылаются аргументы; при росте он создаётся сразу на своём месте
+    template <typename... Args>
+    Iterator Emplace(ConstIterator pos, Args&&... args) {
+        assert(pos >= begin() && pos <= end());
+        size_t index = pos - begin();
+        if (index == size_) {
+            EmplaceBack(std::forward<Args>(args)...);
+            return end() - 1;
+        }
+        if (size_ < capacity_) {
+            Type value(std::forward<Args>(args)...);
+            new (end()) Type(std::move(*(end() - 1)));
+            // Новый последний элемент учитывается сразу: если сдвиг бросит, вектор его разрушит
             ++size_;
-        } else {
-            ArrayPtr<Type> temp(std::max(size_t(1), capacity_ * 2));
-            if(capacity_ != 0) {
-                std::copy(std::make_move_iterator(begin()), std::make_move_iterator(end()), &temp[0]);
-                items_.swap(temp);
-                capacity_ *= 2;
-                items_[size_] = std::move(item);
-                ++size_;
-            } else {
-                temp[0] = std::move(item);
-                items_.swap(temp);
-                capacity_ = 1, size_ = 1;
-            }
+            std::move_backward(begin() + index, end() - 2, end() - 1);
+            items_[index] = std::move(value);
+            return begin() + index;
+        }
+        size_t new_capacity = GrowCapacity(size_ + 1);
+        ArrayPtr<Type, Allocator> temp(new_capacity, GetAllocator());
+        new (temp.Get() + index) Type(std::forward<Args>(args)...);
+        try {
+            TransferElements(begin(), index, temp.Get());
+        } catch (...) {
+            std::destroy_at(temp.Get() + index);
+            throw;
         }
+        try {
+            TransferElements(begin() + index, size_ - index, temp.Get() + index + 1);
+        } catch (...) {
+            std::destroy_n(temp.Get(), index + 1);
+            throw;
+        }
+        DestroyTransferredElements(begin(), size_);
+        items_.swap(temp);
+        instrumentation::RecordReallocation(capacity_, new_capacity);
+        capacity_ = new_capacity;
+        ++size_;
+        return begin() + index;
     }
     
     Iterator Erase(ConstIterator pos) {
-        assert(pos >= begin() && pos <= end());
-        Iterator iter = const_cast<Type*>(pos);
-        std::move(iter+1, end(), iter);
         assert(size_ > 0);
-        size_--;
-        return iter;
+        assert(pos >= begin() && pos < end());
+        return Erase(pos, pos + 1);
     }
-    
-    Iterator Insert(ConstIterator pos, const Type& value) {
-        assert(pos >= begin() && pos <= end());
-        Iterator iter = const_cast<Type*>(pos);
-        if (iter == end()) {
-            PushBack(value);
-            return end() - 1;
+
+    // Удаляет элементы [first, last): хвост сдвигается к first один раз
+    Iterator Erase(ConstIterator first, ConstIterator last) {
+        assert(first >= begin() && first <= last && last <= end());
+        Iterator from = const_cast<Type*>(first);
+        Iterator to = const_cast<Type*>(last);
+        size_t count = to - from;
+        if (count == 0) {
+            return from;
         }
-        if(size_ < capacity_) {
-            std::copy_backward(iter, end(), end()+1);
-            *iter = value;
-            size_++;
+        if constexpr (IS_TRIVIALLY_RELOCATABLE<Type>) {
+            std::destroy(from, to);
+            std::memmove(static_cast<void*>(from), static_cast<const void*>(to), (end() - to) * sizeof(Type));
         } else {
-            ArrayPtr<Type> temp(capacity_ * 2);
-            std::copy(begin(), iter, &temp[0]);
-            for (size_t i = 0; i < size_; ++i) {
-                if(&items_[i] == iter) {
-                    temp[i] = value;
-                    std::copy(iter, end(), &temp[i+1]);
-                }
-            }
-            items_.swap(temp);
-            size_++;
-            capacity_ = std::max(size_, capacity_ * 2); 
+            Iterator new_end = std::move(to, end(), from);
+            std::destroy(new_end, end());
         }
-        return iter;
+        size_ -= count;
+        return from;
+    }
+    
+    Iterator Insert(ConstIterator pos, const Type& value) {
+        return Emplace(pos, value);
     }
 
     Iterator Insert(ConstIterator pos, Type&& value) {
-        Iterator iter = const_cast<Type*>(pos);
-        if (iter == end()) {
-            PushBack(std::move(value));
-            return end() - 1;
-        }
-        if(size_ < capacity_) {
-            std::copy_backward(std::make_move_iterator(iter), std::make_move_iterator(end()), end()+1);
-            *iter = std::move(value);
-            size_++;
+        return Emplace(pos, std::move(value));
+    }
+
+    // Вставляет count копий value перед pos. value может ссылаться на элемент самого вектора
+    Iterator Insert(ConstIterator pos, size_t count, const Type& value) {
+        assert(pos >= begin() && pos <= end());
+        Type copy(value);
+        return InsertWith(pos - begin(), count,
+            [&copy](Type* to, size_t, size_t n) {
+                std::uninitialized_fill_n(to, n, copy);
+            },
+            [&copy](Type* to, size_t, size_t n) {
+                std::fill_n(to, n, copy);
+            });
+    }
+
+    // Вставляет элементы [first, last) перед pos. Диапазон не должен указывать внутрь самого вектора.
+    // Для однопроходных итераторов длина заранее неизвестна, поэтому элементы сначала собираются во временный вектор
+    template <typename InputIt, typename = RequireInputIterator<InputIt>>
+    Iterator Insert(ConstIterator pos, InputIt first, InputIt last) {
+        assert(pos >= begin() && pos <= end());
+        using Category = typename std::iterator_traits<InputIt>::iterator_category;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>) {
+            return InsertWith(pos - begin(), std::distance(first, last),
+                [first](Type* to, size_t offset, size_t n) {
+                    std::uninitialized_copy_n(std::next(first, offset), n, to);
+                },
+                [first](Type* to, size_t offset, size_t n) {
+                    std::copy_n(std::next(first, offset), n, to);
+                });
         } else {
-            ArrayPtr<Type> temp(capacity_ * 2);
-            std::copy(std::make_move_iterator(begin()), std::make_move_iterator(iter), &temp[0]);
-            for (size_t i = 0; i < size_; ++i) {
-                if(&items_[i] == iter) {
-                    temp[i] = std::move(value);
-                    std::copy(std::make_move_iterator(iter), std::make_move_iterator(end()), &temp[i+1]);
-                }
+            size_t index = pos - begin();
+            SimpleVector buffer(GetAllocator());
+            for (; first != last; ++first) {
+                buffer.EmplaceBack(*first);
             }
-            items_.swap(temp);
-            size_++;
-            capacity_ = std::max(size_, capacity_ * 2); 
+            Insert(begin() + index, std::make_move_iterator(buffer.begin()), std::make_move_iterator(buffer.end()));
+            return begin() + index;
         }
-        return iter;
+    }
+
+    Iterator Insert(ConstIterator pos, std::initializer_list<Type> init) {
+        return Insert(pos, init.begin(), init.end());
+    }
+
+    // Дописывает элементы [first, last) в конец, вместимость растёт не больше одного раза
+    template <typename InputIt, typename = RequireInputIterator<InputIt>>
+    void AppendRange(InputIt first, InputIt last) {
+        Insert(end(), first, last);
     }
     
     void PopBack() noexcept {
         assert(size_ != 0);
+        std::destroy_at(end() - 1);
         size_--;
     }
     
@@ -229,6 +404,10 @@ public:
         return capacity_;
     }
 
+    const Allocator& GetAllocator() const noexcept {
+        return items_.GetAllocator();
+    }
+
     bool IsEmpty() const noexcept {
         return size_ == 0;
     }
@@ -263,34 +442,36 @@ public:
 
     // Обнуляет размер массива, не изменяя его вместимость
     void Clear() noexcept {
+        std::destroy_n(begin(), size_);
         size_ = 0;
     }
 
     // Изменяет размер массива.
-    // При увеличении размера новые элементы получают значение по умолчанию для типа Type
+    // При увеличении размера новые элементы получают значение по умолчанию для типа Type.
+    // В пределах вместимости память не перевыделяется и существующие элементы не переносятся
     void Resize(size_t new_size) {
-    
         if (new_size <= size_) {
-            size_ = new_size;
-            return;
-        }
-        
-        if (new_size > capacity_) {
-            ArrayPtr<Type> temp(new_size);
-            std::copy(std::make_move_iterator(begin()), std::make_move_iterator(end()), &temp[0]);
-            items_.swap(temp);
-            capacity_ = std::max(new_size, capacity_*2);
-            size_ = new_size;
-            return;
-        }
-        if (new_size <= capacity_) {
-            ArrayPtr<Type> temp(new_size);
-            std::copy(std::make_move_iterator(begin()), std::make_move_iterator(end()), &temp[0]);
-            items_.swap(temp);
-            size_ = new_size;
+            std::destroy(begin() + new_size, end());
+        } else {
+            if (new_size > capacity_) {
+                Reallocate(GrowCapacity(new_size));
+            }
+            ValueConstruct(end(), new_size - size_);
         }
-        
+        size_ = new_size;
+    }
+    // Невладеющее представление элементов [first, first + count) без копирования.
+    // Действительно до ближайшего перевыделения памяти вектора
+    Span<Type> Subrange(size_t first, size_t count) noexcept {
+        assert(first <= size_ && count <= size_ - first);
+        return {begin() + first, count};
+    }
+
+    Span<const Type> Subrange(size_t first, size_t count) const noexcept {
+        assert(first <= size_ && count <= size_ - first);
+        return {begin() + first, count};
     }
+
     // Возвращает итератор на начало массива
     // Для пустого массива может быть равен (или не равен) nullptr
     Iterator begin() noexcept {
@@ -328,41 +509,146 @@ public:
     }
     
 private:
-    ArrayPtr<Type> items_;
+    // Общая часть вставки count элементов по индексу index. construct(to, offset, n) создаёт в
+    // неинициализированной памяти to элементы вставляемого диапазона [offset, offset + n),
+    // assign(to, offset, n) присваивает их уже живым элементам.
+    // Хвост сдвигается один раз, при нехватке места буфер перевыделяется тоже один раз
+    template <typename Construct, typename Assign>
+    Iterator InsertWith(size_t index, size_t count, Construct construct, Assign assign) {
+        if (count == 0) {
+            return begin() + index;
+        }
+        size_t tail = size_ - index;
+        if (count <= capacity_ - size_) {
+            Iterator pos = begin() + index;
+            Iterator old_end = end();
+            if constexpr (IS_TRIVIALLY_RELOCATABLE<Type>) {
+                // Хвост переносится одним memmove, в освободившемся месте элементы создаются заново
+                std::memmove(static_cast<void*>(pos + count), static_cast<const void*>(pos), tail * sizeof(Type));
+                try {
+                    construct(pos, 0, count);
+                } catch (...) {
+                    std::memmove(static_cast<void*>(pos), static_cast<const void*>(pos + count), tail * sizeof(Type));
+                    throw;
+                }
+                size_ += count;
+            } else if (tail > count) {
+                std::uninitialized_move(old_end - count, old_end, old_end);
+                size_ += count;
+                std::move_backward(pos, old_end - count, old_end);
+                assign(pos, 0, count);
+            } else {
+                construct(old_end, tail, count - tail);
+                size_ += count - tail;
+                std::uninitialized_move(pos, old_end, pos + count);
+                size_ += tail;
+                assign(pos, 0, tail);
+            }
+            return pos;
+        }
+        size_t new_capacity = GrowCapacity(size_ + count);
+        ArrayPtr<Type, Allocator> temp(new_capacity, GetAllocator());
+        construct(temp.Get() + index, 0, count);
+        try {
+            TransferElements(begin(), index, temp.Get());
+        } catch (...) {
+            std::destroy_n(temp.Get() + index, count);
+            throw;
+        }
+        try {
+            TransferElements(begin() + index, tail, temp.Get() + index + count);
+        } catch (...) {
+            std::destroy_n(temp.Get(), index + count);
+            throw;
+        }
+        DestroyTransferredElements(begin(), size_);
+        items_.swap(temp);
+        instrumentation::RecordReallocation(capacity_, new_capacity);
+        capacity_ = new_capacity;
+        size_ += count;
+        return begin() + index;
+    }
+
+    // Медленный путь EmplaceBack вынесен отдельно, чтобы быстрый путь без роста оставался коротким
+    template <typename... Args>
+    void EmplaceBackWithGrowth(Args&&... args) {
+        size_t new_capacity = GrowCapacity(size_ + 1);
+        ArrayPtr<Type, Allocator> temp(new_capacity, GetAllocator());
+        new (temp.Get() + size_) Type(std::forward<Args>(args)...);
+        try {
+            TransferElements(begin(), size_, temp.Get());
+        } catch (...) {
+            std::destroy_at(temp.Get() + size_);
+            throw;
+        }
+        DestroyTransferredElements(begin(), size_);
+        items_.swap(temp);
+        instrumentation::RecordReallocation(capacity_, new_capacity);
+        capacity_ = new_capacity;
+    }
+
+    static void ValueConstruct(Type* to, size_t count) {
+        ConstructInChunks(to, count, [to](size_t first, size_t last) {
+            std::uninitialized_value_construct(to + first, to + last);
+        });
+    }
+
+    size_t GrowCapacity(size_t required) const noexcept {
+        return std::max(required, GrowthPolicy::Grow(capacity_));
+    }
+
+    void Reallocate(size_t new_capacity) {
+        ArrayPtr<Type, Allocator> temp(new_capacity, GetAllocator());
+        TransferElements(begin(), size_, temp.Get());
+        DestroyTransferredElements(begin(), size_);
+        items_.swap(temp);
+        instrumentation::RecordReallocation(capacity_, new_capacity);
+        capacity_ = new_capacity;
+    }
+
+    ArrayPtr<Type, Allocator> items_;
     size_t size_ = 0;
     size_t capacity_ = 0;
 };
 
-template <typename Type>
-inline bool operator==(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+// Для арифметических типов сравнение идёт векторизованными ядрами из simd_kernels.h
+template <typename Type, typename Allocator, typename GrowthPolicy>
+inline bool operator==(const SimpleVector<Type, Allocator, GrowthPolicy>& lhs, const SimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
     if (lhs.GetSize() != rhs.GetSize()) {
         return false;
     }
-    return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    if constexpr (simd::IS_VECTORIZABLE<Type>) {
+        return simd::Equal(lhs.begin(), rhs.begin(), lhs.GetSize());
+    } else {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
 }
 
-template <typename Type>
-inline bool operator!=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Allocator, typename GrowthPolicy>
+inline bool operator!=(const SimpleVector<Type, Allocator, GrowthPolicy>& lhs, const SimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
     return !operator==(lhs, rhs);
 }
 
-template <typename Type>
-inline bool operator<(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
-    return std::lexicographical_compare(rhs.begin(), rhs.end(), lhs.begin(), lhs.end());
+template <typename Type, typename Allocator, typename GrowthPolicy>
+inline bool operator<(const SimpleVector<Type, Allocator, GrowthPolicy>& lhs, const SimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
+    if constexpr (simd::IS_VECTORIZABLE<Type>) {
+        return simd::LexicographicalLess(lhs.begin(), lhs.GetSize(), rhs.begin(), rhs.GetSize());
+    } else {
+        return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
 }
 
-template <typename Type>
-inline bool operator<=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
-    return !std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+template <typename Type, typename Allocator, typename GrowthPolicy>
+inline bool operator<=(const SimpleVector<Type, Allocator, GrowthPolicy>& lhs, const SimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
+    return !(rhs < lhs);
 }
 
-template <typename Type>
-inline bool operator>(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
-    return std::lexicographical_compare(rhs.cbegin(), rhs.cend(), lhs.cbegin(), lhs.cend());
+template <typename Type, typename Allocator, typename GrowthPolicy>
+inline bool operator>(const SimpleVector<Type, Allocator, GrowthPolicy>& lhs, const SimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
+    return rhs < lhs;
 }
 
-template <typename Type>
-inline bool operator>=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
-    return !std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
-} 
-
+template <typename Type, typename Allocator, typename GrowthPolicy>
+inline bool operator>=(const SimpleVector<Type, Allocator, GrowthPolicy>& lhs, const SimpleVector<Type, Allocator, GrowthPolicy>& rhs) {
+    return !(lhs < rhs);
+}
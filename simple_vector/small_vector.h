@@ -0,0 +1,324 @@
+#pragma once
+
+#include <cassert>
+#include <initializer_list>
+#include <cstddef>
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include "simple_vector.h"
+
+// Вектор с интерфейсом SimpleVector, который держит до N элементов прямо в объекте
+// и обращается к куче, только когда элементов становится больше N
+template <typename Type, size_t N>
+class SmallVector {
+    static_assert(N > 0, "SmallVector needs at least one inline element");
+
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+
+    SmallVector() noexcept = default;
+
+    explicit SmallVector(size_t size) {
+        Reserve(size);
+        std::uninitialized_value_construct_n(begin(), size);
+        size_ = size;
+    }
+
+    SmallVector(size_t size, const Type& value) {
+        Reserve(size);
+        std::uninitialized_fill_n(begin(), size, value);
+        size_ = size;
+    }
+
+    // Создаёт вектор из std::initializer_list
+    SmallVector(std::initializer_list<Type> init) {
+        Reserve(init.size());
+        std::uninitialized_copy(init.begin(), init.end(), begin());
+        size_ = init.size();
+    }
+
+    explicit SmallVector(ReserveProxyObj obj) {
+        Reserve(obj.GetCapacity());
+    }
+
+    SmallVector(const SmallVector& other) {
+        Reserve(other.size_);
+        std::uninitialized_copy(other.begin(), other.end(), begin());
+        size_ = other.size_;
+    }
+
+    // Из кучи буфер забирается целиком, из встроенного хранилища элементы переносятся поштучно
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<Type>) {
+        swap(other);
+    }
+
+    SmallVector& operator=(const SmallVector& rhs) {
+        if (this != &rhs) {
+            auto rhscopy(rhs);
+            swap(rhscopy);
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& rhs) noexcept(std::is_nothrow_move_constructible_v<Type>) {
+        if (this != &rhs) {
+            Clear();
+            swap(rhs);
+        }
+        return *this;
+    }
+
+    ~SmallVector() {
+        std::destroy_n(begin(), size_);
+    }
+
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > capacity_) {
+            Reallocate(new_capacity);
+        }
+    }
+
+    void PushBack(const Type& item) {
+        EmplaceBack(item);
+    }
+
+    void PushBack(Type&& item) {
+        EmplaceBack(std::move(item));
+    }
+
+    // Как и в SimpleVector, при росте новый элемент создаётся раньше, чем переносятся старые,
+    // поэтому аргументы могут ссылаться на элементы этого же вектора
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        if (size_ < capacity_) {
+            new (end()) Type(std::forward<Args>(args)...);
+        } else {
+            size_t new_capacity = capacity_ * 2;
+            ArrayPtr<Type> temp(new_capacity);
+            new (temp.Get() + size_) Type(std::forward<Args>(args)...);
+            try {
+                TransferElements(begin(), size_, temp.Get());
+            } catch (...) {
+                std::destroy_at(temp.Get() + size_);
+                throw;
+            }
+            DestroyTransferredElements(begin(), size_);
+            heap_.swap(temp);
+            data_ = heap_.Get();
+            capacity_ = new_capacity;
+        }
+        ++size_;
+        return *(end() - 1);
+    }
+
+    // Элемент создаётся в конце и затем поворотом встаёт на место pos
+    template <typename... Args>
+    Iterator Emplace(ConstIterator pos, Args&&... args) {
+        assert(pos >= begin() && pos <= end());
+        size_t index = pos - begin();
+        EmplaceBack(std::forward<Args>(args)...);
+        std::rotate(begin() + index, end() - 1, end());
+        return begin() + index;
+    }
+
+    Iterator Insert(ConstIterator pos, const Type& value) {
+        return Emplace(pos, value);
+    }
+
+    Iterator Insert(ConstIterator pos, Type&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    Iterator Erase(ConstIterator pos) {
+        assert(size_ > 0);
+        assert(pos >= begin() && pos < end());
+        Iterator iter = const_cast<Type*>(pos);
+        std::move(iter + 1, end(), iter);
+        PopBack();
+        return iter;
+    }
+
+    void PopBack() noexcept {
+        assert(size_ != 0);
+        std::destroy_at(end() - 1);
+        size_--;
+    }
+
+    // Если оба буфера в куче, обмениваются указателями. Встроенные элементы переносятся
+    // в освободившееся встроенное хранилище другого вектора
+    void swap(SmallVector& other) noexcept(std::is_nothrow_move_constructible_v<Type>) {
+        if (!IsInline() && !other.IsInline()) {
+            heap_.swap(other.heap_);
+            std::swap(data_, other.data_);
+        } else if (IsInline() && other.IsInline()) {
+            SmallVector& longer = size_ >= other.size_ ? *this : other;
+            SmallVector& shorter = size_ >= other.size_ ? other : *this;
+            std::swap_ranges(shorter.begin(), shorter.end(), longer.begin());
+            std::uninitialized_move(longer.begin() + shorter.size_, longer.end(), shorter.end());
+            std::destroy(longer.begin() + shorter.size_, longer.end());
+        } else {
+            SmallVector& on_heap = IsInline() ? other : *this;
+            SmallVector& in_place = IsInline() ? *this : other;
+            std::uninitialized_move(in_place.begin(), in_place.end(), on_heap.InlineData());
+            std::destroy(in_place.begin(), in_place.end());
+            in_place.heap_.swap(on_heap.heap_);
+            in_place.data_ = in_place.heap_.Get();
+            on_heap.data_ = on_heap.InlineData();
+        }
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+    }
+
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    size_t GetCapacity() const noexcept {
+        return capacity_;
+    }
+
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    // Возвращает true, пока элементы лежат во встроенном хранилище
+    bool IsInline() const noexcept {
+        return data_ == InlineData();
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    Type& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return data_[index];
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    const Type& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return data_[index];
+    }
+
+    Type& At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("out_of_range");
+        }
+        return data_[index];
+    }
+
+    const Type& At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("out_of_range");
+        }
+        return data_[index];
+    }
+
+    // Обнуляет размер массива, не изменяя его вместимость
+    void Clear() noexcept {
+        std::destroy_n(begin(), size_);
+        size_ = 0;
+    }
+
+    // Изменяет размер массива.
+    // При увеличении размера новые элементы получают значение по умолчанию для типа Type
+    void Resize(size_t new_size) {
+        if (new_size <= size_) {
+            std::destroy(begin() + new_size, end());
+        } else {
+            if (new_size > capacity_) {
+                Reallocate(std::max(new_size, capacity_ * 2));
+            }
+            std::uninitialized_value_construct(end(), begin() + new_size);
+        }
+        size_ = new_size;
+    }
+
+    Iterator begin() noexcept {
+        return data_;
+    }
+
+    Iterator end() noexcept {
+        return data_ + size_;
+    }
+
+    ConstIterator begin() const noexcept {
+        return data_;
+    }
+
+    ConstIterator end() const noexcept {
+        return data_ + size_;
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return data_;
+    }
+
+    ConstIterator cend() const noexcept {
+        return data_ + size_;
+    }
+
+private:
+    Type* InlineData() noexcept {
+        return reinterpret_cast<Type*>(inline_storage_);
+    }
+
+    const Type* InlineData() const noexcept {
+        return reinterpret_cast<const Type*>(inline_storage_);
+    }
+
+    void Reallocate(size_t new_capacity) {
+        ArrayPtr<Type> temp(new_capacity);
+        TransferElements(begin(), size_, temp.Get());
+        DestroyTransferredElements(begin(), size_);
+        heap_.swap(temp);
+        data_ = heap_.Get();
+        capacity_ = new_capacity;
+    }
+
+    alignas(Type) unsigned char inline_storage_[N * sizeof(Type)];
+    ArrayPtr<Type> heap_;
+    Type* data_ = InlineData();
+    size_t size_ = 0;
+    size_t capacity_ = N;
+};
+
+template <typename Type, size_t N>
+void swap(SmallVector<Type, N>& lhs, SmallVector<Type, N>& rhs) noexcept(noexcept(lhs.swap(rhs))) {
+    lhs.swap(rhs);
+}
+
+template <typename Type, size_t N>
+inline bool operator==(const SmallVector<Type, N>& lhs, const SmallVector<Type, N>& rhs) {
+    if (lhs.GetSize() != rhs.GetSize()) {
+        return false;
+    }
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename Type, size_t N>
+inline bool operator!=(const SmallVector<Type, N>& lhs, const SmallVector<Type, N>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, size_t N>
+inline bool operator<(const SmallVector<Type, N>& lhs, const SmallVector<Type, N>& rhs) {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename Type, size_t N>
+inline bool operator<=(const SmallVector<Type, N>& lhs, const SmallVector<Type, N>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Type, size_t N>
+inline bool operator>(const SmallVector<Type, N>& lhs, const SmallVector<Type, N>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type, size_t N>
+inline bool operator>=(const SmallVector<Type, N>& lhs, const SmallVector<Type, N>& rhs) {
+    return !(lhs < rhs);
+}
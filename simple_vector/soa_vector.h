@@ -0,0 +1,324 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "simple_vector.h"
+#include "span.h"
+
+// Структура массивов: каждое поле записи хранится в своём непрерывном столбце SimpleVector<Field>.
+// Цикл по одному-двум полям читает только их столбцы, не таская через кэш остальные поля записи,
+// и компилятор может его векторизовать. Строка доступна через прокси-ссылку - кортеж ссылок на поля.
+// Столбцы растут вместе: сначала все резервируют место, затем элемент добавляется в каждый;
+// если конструктор поля бросил исключение, уже добавленные поля строки удаляются
+template <typename... Fields>
+class SoaVector {
+    static_assert(sizeof...(Fields) > 0, "SoaVector needs at least one field");
+
+    using Indices = std::index_sequence_for<Fields...>;
+
+public:
+    template <size_t I>
+    using FieldType = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+    // Присваивание прокси-ссылке пишет в столбцы: v[i] = v.GetRow(j) или std::get<1>(v[i]) = price
+    using Reference = std::tuple<Fields&...>;
+    using ConstReference = std::tuple<const Fields&...>;
+    using Value = std::tuple<Fields...>;
+
+    template <bool IsConst>
+    class RowIterator;
+
+    using Iterator = RowIterator<false>;
+    using ConstIterator = RowIterator<true>;
+
+    SoaVector() noexcept = default;
+
+    explicit SoaVector(size_t size)
+    : columns_(SimpleVector<Fields>(size)...)
+    {
+    }
+
+    explicit SoaVector(ReserveProxyObj obj)
+    : columns_(SimpleVector<Fields>(obj)...)
+    {
+    }
+
+    size_t GetSize() const noexcept {
+        return std::get<0>(columns_).GetSize();
+    }
+
+    // Вместимость самого тесного столбца: столько строк добавится без перевыделений
+    size_t GetCapacity() const noexcept {
+        return std::apply([](const auto&... column) {
+            return std::min({column.GetCapacity()...});
+        }, columns_);
+    }
+
+    bool IsEmpty() const noexcept {
+        return GetSize() == 0;
+    }
+
+    void Reserve(size_t new_capacity) {
+        std::apply([new_capacity](auto&... column) {
+            (column.Reserve(new_capacity), ...);
+        }, columns_);
+    }
+
+    // Принимает значения всех полей по порядку. Значения могут ссылаться на строки самого вектора:
+    // если столбцы будут перевыделены, строка сначала собирается целиком, а уже потом
+    // старые строки переезжают в новые буферы
+    template <typename... Values>
+    void PushBack(Values&&... values) {
+        static_assert(sizeof...(Values) == sizeof...(Fields), "PushBack needs a value for every field");
+        if (GetSize() == GetCapacity()) {
+            Value row(std::forward<Values>(values)...);
+            GrowForOneMore();
+            AppendRow(std::move(row));
+        } else {
+            AppendRow(std::forward_as_tuple(std::forward<Values>(values)...));
+        }
+    }
+
+    // Вставляет строку перед строкой index. Строка собирается до сдвига столбцов,
+    // поэтому значения тоже могут ссылаться на строки самого вектора
+    template <typename... Values>
+    void Insert(size_t index, Values&&... values) {
+        static_assert(sizeof...(Values) == sizeof...(Fields), "Insert needs a value for every field");
+        assert(index <= GetSize());
+        Value args(std::forward<Values>(values)...);
+        GrowForOneMore();
+        ForEachColumnOrRollback(
+            [&args, index](auto& column, auto field) {
+                column.Emplace(column.begin() + index, std::get<decltype(field)::value>(std::move(args)));
+            },
+            [index](auto& column) {
+                column.Erase(column.begin() + index);
+            });
+    }
+
+    void Erase(size_t index) {
+        assert(index < GetSize());
+        Erase(index, index + 1);
+    }
+
+    // Удаляет строки [first, last): каждый столбец сдвигается один раз
+    void Erase(size_t first, size_t last) {
+        assert(first <= last && last <= GetSize());
+        std::apply([first, last](auto&... column) {
+            (column.Erase(column.begin() + first, column.begin() + last), ...);
+        }, columns_);
+    }
+
+    void PopBack() noexcept {
+        assert(!IsEmpty());
+        std::apply([](auto&... column) {
+            (column.PopBack(), ...);
+        }, columns_);
+    }
+
+    void Clear() noexcept {
+        std::apply([](auto&... column) {
+            (column.Clear(), ...);
+        }, columns_);
+    }
+
+    void Resize(size_t new_size) {
+        size_t old_size = GetSize();
+        Reserve(new_size);
+        ForEachColumnOrRollback(
+            [new_size](auto& column, auto) {
+                column.Resize(new_size);
+            },
+            [old_size](auto& column) {
+                column.Resize(old_size);
+            });
+    }
+
+    void swap(SoaVector& other) noexcept {
+        SwapColumns(other, Indices{});
+    }
+
+    // Столбец поля I целиком, без копирования. Действителен до ближайшего перевыделения
+    template <size_t I>
+    Span<FieldType<I>> Column() noexcept {
+        auto& column = std::get<I>(columns_);
+        return {column.begin(), column.GetSize()};
+    }
+
+    template <size_t I>
+    Span<const FieldType<I>> Column() const noexcept {
+        const auto& column = std::get<I>(columns_);
+        return {column.begin(), column.GetSize()};
+    }
+
+    Reference operator[](size_t index) noexcept {
+        assert(index < GetSize());
+        return MakeRow(*this, index, Indices{});
+    }
+
+    ConstReference operator[](size_t index) const noexcept {
+        assert(index < GetSize());
+        return MakeRow(*this, index, Indices{});
+    }
+
+    Reference At(size_t index) {
+        if (index >= GetSize()) {
+            throw std::out_of_range("out_of_range");
+        }
+        return (*this)[index];
+    }
+
+    ConstReference At(size_t index) const {
+        if (index >= GetSize()) {
+            throw std::out_of_range("out_of_range");
+        }
+        return (*this)[index];
+    }
+
+    // Копия строки, не связанная со столбцами
+    Value GetRow(size_t index) const {
+        return Value((*this)[index]);
+    }
+
+    Iterator begin() noexcept {
+        return {this, 0};
+    }
+
+    Iterator end() noexcept {
+        return {this, GetSize()};
+    }
+
+    ConstIterator begin() const noexcept {
+        return {this, 0};
+    }
+
+    ConstIterator end() const noexcept {
+        return {this, GetSize()};
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+    bool operator==(const SoaVector& other) const {
+        return columns_ == other.columns_;
+    }
+
+    bool operator!=(const SoaVector& other) const {
+        return !(*this == other);
+    }
+
+    // Итератор по строкам. operator* возвращает прокси-ссылку по значению, поэтому
+    // для алгоритмов стандартной библиотеки это только однопроходный итератор
+    template <bool IsConst>
+    class RowIterator {
+        using Owner = std::conditional_t<IsConst, const SoaVector, SoaVector>;
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Value;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = std::conditional_t<IsConst, ConstReference, Reference>;
+
+        RowIterator() noexcept = default;
+
+        RowIterator(Owner* owner, size_t index) noexcept
+        : owner_(owner), index_(index)
+        {
+        }
+
+        reference operator*() const noexcept {
+            return (*owner_)[index_];
+        }
+
+        RowIterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+
+        RowIterator operator++(int) noexcept {
+            RowIterator old = *this;
+            ++index_;
+            return old;
+        }
+
+        size_t GetIndex() const noexcept {
+            return index_;
+        }
+
+        bool operator==(const RowIterator& other) const noexcept {
+            return owner_ == other.owner_ && index_ == other.index_;
+        }
+
+        bool operator!=(const RowIterator& other) const noexcept {
+            return !(*this == other);
+        }
+
+    private:
+        Owner* owner_ = nullptr;
+        size_t index_ = 0;
+    };
+
+private:
+    // Дописывает строку из кортежа значений полей; места во всех столбцах уже хватает
+    template <typename Row>
+    void AppendRow(Row&& row) {
+        ForEachColumnOrRollback(
+            [&row](auto& column, auto field) {
+                column.EmplaceBack(std::get<decltype(field)::value>(std::forward<Row>(row)));
+            },
+            [](auto& column) {
+                column.PopBack();
+            });
+    }
+
+    void GrowForOneMore() {
+        size_t size = GetSize();
+        if (size == GetCapacity()) {
+            Reserve(std::max(size + 1, DoublingGrowth::Grow(GetCapacity())));
+        }
+    }
+
+    // Вызывает apply(column, std::integral_constant<size_t, I>) для столбцов по порядку.
+    // Если столбец бросил исключение, для уже обработанных столбцов вызывается undo(column)
+    template <typename Apply, typename Undo>
+    void ForEachColumnOrRollback(Apply apply, Undo undo) {
+        ForEachColumnOrRollback(apply, undo, Indices{});
+    }
+
+    template <typename Apply, typename Undo, size_t... I>
+    void ForEachColumnOrRollback(Apply& apply, Undo& undo, std::index_sequence<I...>) {
+        size_t done = 0;
+        try {
+            ((apply(std::get<I>(columns_), std::integral_constant<size_t, I>{}), ++done), ...);
+        } catch (...) {
+            size_t column = 0;
+            ((column++ < done ? undo(std::get<I>(columns_)) : void()), ...);
+            throw;
+        }
+    }
+
+    template <size_t... I>
+    void SwapColumns(SoaVector& other, std::index_sequence<I...>) noexcept {
+        (std::get<I>(columns_).swap(std::get<I>(other.columns_)), ...);
+    }
+
+    template <typename Self, size_t... I>
+    static auto MakeRow(Self& self, size_t index, std::index_sequence<I...>) noexcept {
+        return std::conditional_t<std::is_const_v<Self>, ConstReference, Reference>(
+            std::get<I>(self.columns_)[index]...);
+    }
+
+    std::tuple<SimpleVector<Fields>...> columns_;
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+// Невладеющее представление непрерывного участка массива: указатель и длина, как std::span из C++20.
+// Элементы принадлежат контейнеру, и Span действителен, пока контейнер не перевыделит память
+template <typename Type>
+class Span {
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+
+    constexpr Span() noexcept = default;
+
+    constexpr Span(Type* data, size_t size) noexcept
+    : data_(data), size_(size)
+    {
+    }
+
+    // Span<const Type> из Span<Type>
+    template <typename Other, typename = std::enable_if_t<std::is_convertible_v<Other (*)[], Type (*)[]>>>
+    constexpr Span(Span<Other> other) noexcept
+    : data_(other.Data()), size_(other.GetSize())
+    {
+    }
+
+    constexpr Type* Data() const noexcept {
+        return data_;
+    }
+
+    constexpr size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    constexpr bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    constexpr Type& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return data_[index];
+    }
+
+    // Часть представления [first, first + count), тоже без копирования
+    constexpr Span Subspan(size_t first, size_t count) const noexcept {
+        assert(first <= size_ && count <= size_ - first);
+        return {data_ + first, count};
+    }
+
+    constexpr Iterator begin() const noexcept {
+        return data_;
+    }
+
+    constexpr Iterator end() const noexcept {
+        return data_ + size_;
+    }
+
+private:
+    Type* data_ = nullptr;
+    size_t size_ = 0;
+};
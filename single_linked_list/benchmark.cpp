@@ -0,0 +1,283 @@
+#include "intrusive_list.h"
+#include "lock_free_list.h"
+#include "node_pool.h"
+#include "single-linked-list.h"
+#include "unrolled_list.h"
+
+#include <chrono>
+#include <forward_list>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Печатает время жизни объекта в миллисекундах
+class LogDuration {
+public:
+    explicit LogDuration(string id)
+        : id_(move(id)) {
+    }
+    ~LogDuration() {
+        const auto duration = chrono::steady_clock::now() - start_;
+        cerr << id_ << ": " << chrono::duration_cast<chrono::milliseconds>(duration).count() << " ms" << endl;
+    }
+
+private:
+    const string id_;
+    const chrono::steady_clock::time_point start_ = chrono::steady_clock::now();
+};
+
+// Очередь с постоянной сменой элементов: вставки и удаления вперемешку, затем обход и очистка
+template <typename List>
+void BenchmarkChurn(const string& name) {
+    const int size = 1'000'000;
+    const int rounds = 20;
+    long long total = 0;
+    List list;
+    {
+        LogDuration guard(name + " PushFront/EraseAfter churn"s);
+        for (int i = 0; i < size; ++i) {
+            list.PushFront(i);
+        }
+        for (int round = 0; round < rounds; ++round) {
+            auto pos = list.cbegin();
+            for (int i = 0; i < size / 2 && pos != list.cend(); ++i) {
+                list.EraseAfter(pos);
+                pos = list.InsertAfter(pos, i);
+            }
+            for (int i = 0; i < size / 10; ++i) {
+                list.PopFront();
+                list.PushFront(i);
+            }
+        }
+    }
+    {
+        LogDuration guard(name + " traversal x 10"s);
+        for (int pass = 0; pass < 10; ++pass) {
+            for (int value : list) {
+                total += value;
+            }
+        }
+    }
+    {
+        LogDuration guard(name + " Clear"s);
+        list.Clear();
+    }
+    cout << total << endl;
+}
+
+void BenchmarkNodePool() {
+    BenchmarkChurn<SingleLinkedList<int>>("SingleLinkedList<int>"s);
+    BenchmarkChurn<SingleLinkedList<int, PoolAllocator<int>>>("SingleLinkedList<int, PoolAllocator>"s);
+}
+
+// Вставки после каждого элемента в несколько проходов: соседние элементы списка оказываются
+// созданными в разное время, затем обход
+template <typename List>
+void BenchmarkInsertAndTraverse(const string& name) {
+    const int initial = 1 << 16;
+    const int passes = 4;
+    long long total = 0;
+    List list;
+    for (int i = 0; i < initial; ++i) {
+        list.PushFront(i);
+    }
+    {
+        LogDuration guard(name + " InsertAfter every element x "s + to_string(passes));
+        for (int pass = 0; pass < passes; ++pass) {
+            for (auto pos = list.cbegin(); pos != list.cend(); ++pos) {
+                pos = list.InsertAfter(pos, pass);
+            }
+        }
+    }
+    {
+        LogDuration guard(name + " traversal x 50 of "s + to_string(list.GetSize()));
+        for (int pass = 0; pass < 50; ++pass) {
+            for (int value : list) {
+                total += value;
+            }
+        }
+    }
+    cout << total << endl;
+}
+
+void BenchmarkUnrolledList() {
+    BenchmarkInsertAndTraverse<SingleLinkedList<int>>("SingleLinkedList<int>"s);
+    BenchmarkInsertAndTraverse<UnrolledList<int>>("UnrolledList<int>"s);
+    BenchmarkInsertAndTraverse<UnrolledList<int, 8>>("UnrolledList<int, 8>"s);
+}
+
+// Копирование и сортировка перестановкой узлов против std::forward_list
+void BenchmarkCopyAndSort() {
+    const int size = 1'000'000;
+    mt19937 generator(1);
+    vector<string> values;
+    for (int i = 0; i < size; ++i) {
+        values.push_back(to_string(generator()));
+    }
+    size_t total = 0;
+    {
+        SingleLinkedList<string> list(values.begin(), values.end());
+        {
+            LogDuration guard("SingleLinkedList<string> copy x "s + to_string(size));
+            SingleLinkedList<string> copy(list);
+            total += copy.GetSize();
+        }
+        {
+            LogDuration guard("SingleLinkedList<string> Sort x "s + to_string(size));
+            list.Sort();
+        }
+        total += list.begin()->size();
+    }
+    {
+        forward_list<string> list(values.begin(), values.end());
+        {
+            LogDuration guard("forward_list<string> copy x "s + to_string(size));
+            forward_list<string> copy(list);
+            total += copy.front().size();
+        }
+        {
+            LogDuration guard("forward_list<string> sort x "s + to_string(size));
+            list.sort();
+        }
+        total += list.front().size();
+    }
+    cout << total << endl;
+}
+
+// Стек задач под мьютексом, как его использовали до LockFreeStack
+class MutexStack {
+public:
+    void Push(int value) {
+        lock_guard guard(mutex_);
+        list_.PushFront(value);
+    }
+
+    optional<int> TryPop() {
+        lock_guard guard(mutex_);
+        if (list_.IsEmpty()) {
+            return nullopt;
+        }
+        int value = *list_.begin();
+        list_.PopFront();
+        return value;
+    }
+
+private:
+    mutex mutex_;
+    SingleLinkedList<int> list_;
+};
+
+// Каждый поток кладёт элемент и снимает чужой или свой: передача работы при полной конкуренции
+template <typename Stack>
+void BenchmarkHandoff(const string& name, int threads) {
+    const int total_operations = 4'000'000;
+    const int per_thread = total_operations / threads;
+    Stack stack;
+    long long sum = 0;
+    mutex sum_mutex;
+    {
+        LogDuration guard(name + " push+pop x "s + to_string(total_operations) + ", threads "s + to_string(threads));
+        vector<thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&stack, &sum, &sum_mutex, per_thread] {
+                long long local = 0;
+                for (int i = 0; i < per_thread; ++i) {
+                    stack.Push(i);
+                    if (auto value = stack.TryPop()) {
+                        local += *value;
+                    }
+                }
+                lock_guard guard(sum_mutex);
+                sum += local;
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+    while (auto value = stack.TryPop()) {
+        sum += *value;
+    }
+    cout << sum << endl;
+}
+
+// Масштабирование видно, только пока потоков не больше, чем аппаратных потоков: иначе потоки
+// выполняются по очереди, конкуренции почти нет, и сравнивается лишь цена одной операции.
+// Порядок стеков чередуется, чтобы ни один не получал прогретые другим кэши
+void BenchmarkLockFreeStack() {
+    const unsigned hardware_threads = thread::hardware_concurrency();
+    cerr << "hardware threads: "s << hardware_threads << endl;
+    bool mutex_first = true;
+    for (int threads : {1, 2, 4, 8}) {
+        if (static_cast<unsigned>(threads) > hardware_threads) {
+            cerr << "threads "s << threads << " > hardware threads: no real contention, per-operation cost only"s
+                 << endl;
+        }
+        if (mutex_first) {
+            BenchmarkHandoff<MutexStack>("mutex SingleLinkedList"s, threads);
+            BenchmarkHandoff<LockFreeStack<int>>("LockFreeStack"s, threads);
+        } else {
+            BenchmarkHandoff<LockFreeStack<int>>("LockFreeStack"s, threads);
+            BenchmarkHandoff<MutexStack>("mutex SingleLinkedList"s, threads);
+        }
+        mutex_first = !mutex_first;
+    }
+}
+
+// Объекты уже лежат в массиве; очередь готовых перекладывает их туда и обратно
+struct Job {
+    int id = 0;
+    char payload[56] = {};
+    IntrusiveListHook<Job> hook;
+};
+
+void BenchmarkIntrusiveList() {
+    const int jobs_count = 100'000;
+    const int rounds = 50;
+    vector<Job> jobs(jobs_count);
+    for (int i = 0; i < jobs_count; ++i) {
+        jobs[i].id = i;
+    }
+    long long total = 0;
+    {
+        LogDuration guard("SingleLinkedList<Job> PushFront/PopFront x "s + to_string(jobs_count * rounds));
+        SingleLinkedList<Job> list;
+        for (int round = 0; round < rounds; ++round) {
+            for (const Job& job : jobs) {
+                list.PushFront(job);
+            }
+            while (!list.IsEmpty()) {
+                total += list.begin()->id;
+                list.PopFront();
+            }
+        }
+    }
+    {
+        LogDuration guard("IntrusiveSingleLinkedList<Job> PushFront/PopFront x "s + to_string(jobs_count * rounds));
+        IntrusiveSingleLinkedList<Job, &Job::hook> list;
+        for (int round = 0; round < rounds; ++round) {
+            for (Job& job : jobs) {
+                list.PushFront(job);
+            }
+            while (!list.IsEmpty()) {
+                total += list.begin()->id;
+                list.PopFront();
+            }
+        }
+    }
+    cout << total << endl;
+}
+
+int main() {
+    BenchmarkNodePool();
+    BenchmarkUnrolledList();
+    BenchmarkCopyAndSort();
+    BenchmarkLockFreeStack();
+    BenchmarkIntrusiveList();
+}
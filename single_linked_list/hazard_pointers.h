@@ -0,0 +1,189 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// Опасные указатели для безопасного освобождения узлов в структурах без блокировок.
+// Поток, который собирается прочитать узел, публикует его адрес через Protect; удалённый из
+// структуры узел отдаётся в Retire и освобождается, только когда ни один поток его не защищает.
+// Поэтому память узла не переиспользуется, пока на неё кто-то смотрит, и сравнение указателей
+// в CAS не ошибается из-за повторно выделенного узла по тому же адресу (проблема ABA).
+// У каждого потока одна запись: в каждый момент он защищает не больше одного узла
+class HazardPointers {
+public:
+    // Публикует значение src как защищённое и возвращает его. Значение перечитывается,
+    // пока не совпадёт с опубликованным: узел, прочитанный после публикации, ещё не отдан в Retire
+    template <typename Node>
+    static Node* Protect(const std::atomic<Node*>& src) {
+        std::atomic<const void*>& hazard = GetThreadState().record->hazard;
+        Node* ptr = src.load(std::memory_order_relaxed);
+        while (true) {
+            hazard.store(ptr);
+            Node* current = src.load();
+            if (current == ptr) {
+                return ptr;
+            }
+            ptr = current;
+        }
+    }
+
+    // Снимает защиту текущего потока
+    static void Clear() noexcept {
+        GetThreadState().record->hazard.store(nullptr, std::memory_order_release);
+    }
+
+    // Откладывает освобождение узла, уже недостижимого из структуры
+    template <typename Node>
+    static void Retire(Node* node) {
+        Retire(node, [](void* ptr) {
+            delete static_cast<Node*>(ptr);
+        });
+    }
+
+    // То же, но узел освобождает deleter - например, возвращает его в кэш узлов
+    static void Retire(void* node, void (*deleter)(void*)) {
+        ThreadState& state = GetThreadState();
+        state.retired.push_back({node, deleter});
+        // Порог растёт с числом потоков, чтобы каждый просмотр освобождал больше, чем стоит
+        if (state.retired.size() >= 2 * GetRecordCount() + 64) {
+            Scan(state);
+        }
+    }
+
+private:
+    struct Record {
+        std::atomic<const void*> hazard{nullptr};
+        std::atomic<bool> active{false};
+        Record* next = nullptr;
+    };
+
+    struct Retired {
+        void* ptr;
+        void (*deleter)(void*);
+    };
+
+    // Записи не удаляются до конца программы, а освободившиеся берут новые потоки
+    struct Registry {
+        Registry() = default;
+        Registry(const Registry&) = delete;
+        Registry& operator=(const Registry&) = delete;
+
+        // К этому моменту потоков не осталось, и ничего не защищено
+        ~Registry() {
+            for (const Retired& retired : orphans) {
+                retired.deleter(retired.ptr);
+            }
+            Record* record = records.load();
+            while (record != nullptr) {
+                delete std::exchange(record, record->next);
+            }
+        }
+
+        std::atomic<Record*> records{nullptr};
+        std::atomic<size_t> record_count{0};
+        // Узлы завершившихся потоков, которые тогда ещё были защищены
+        std::mutex orphans_mutex;
+        std::vector<Retired> orphans;
+    };
+
+    struct ThreadState {
+        ThreadState()
+            : record(AcquireRecord()) {
+        }
+
+        ~ThreadState() {
+            record->hazard.store(nullptr);
+            Scan(*this);
+            if (!retired.empty()) {
+                Registry& registry = GetRegistry();
+                std::lock_guard lock(registry.orphans_mutex);
+                registry.orphans.insert(registry.orphans.end(), retired.begin(), retired.end());
+            }
+            record->active.store(false, std::memory_order_release);
+        }
+
+        Record* record;
+        std::vector<Retired> retired;
+        // Буфер для просмотра, чтобы не выделять память при каждом просмотре
+        std::vector<const void*> hazards;
+    };
+
+    static Registry& GetRegistry() {
+        static Registry registry;
+        return registry;
+    }
+
+    static ThreadState& GetThreadState() {
+        // Реестр создаётся раньше состояния потока и поэтому разрушается позже
+        GetRegistry();
+        thread_local ThreadState state;
+        return state;
+    }
+
+    static size_t GetRecordCount() noexcept {
+        return GetRegistry().record_count.load(std::memory_order_relaxed);
+    }
+
+    static Record* AcquireRecord() {
+        Registry& registry = GetRegistry();
+        for (Record* record = registry.records.load(std::memory_order_acquire); record != nullptr;
+             record = record->next) {
+            bool expected = false;
+            if (!record->active.load(std::memory_order_relaxed)
+                && record->active.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                return record;
+            }
+        }
+        Record* record = new Record;
+        record->active.store(true, std::memory_order_relaxed);
+        record->next = registry.records.load(std::memory_order_relaxed);
+        while (!registry.records.compare_exchange_weak(record->next, record, std::memory_order_release,
+                                                       std::memory_order_relaxed)) {
+        }
+        registry.record_count.fetch_add(1, std::memory_order_relaxed);
+        return record;
+    }
+
+    // Освобождает отложенные узлы, которые никто не защищает; заодно разбирает узлы
+    // завершившихся потоков
+    static void Scan(ThreadState& state) {
+        Registry& registry = GetRegistry();
+        {
+            std::unique_lock lock(registry.orphans_mutex, std::try_to_lock);
+            if (lock.owns_lock() && !registry.orphans.empty()) {
+                state.retired.insert(state.retired.end(), registry.orphans.begin(), registry.orphans.end());
+                registry.orphans.clear();
+            }
+        }
+        std::vector<const void*>& hazards = state.hazards;
+        hazards.clear();
+        for (Record* record = registry.records.load(std::memory_order_acquire); record != nullptr;
+             record = record->next) {
+            if (const void* hazard = record->hazard.load()) {
+                hazards.push_back(hazard);
+            }
+        }
+        // Частый случай: никто ничего не защищает, и освобождается всё без поиска
+        if (hazards.empty()) {
+            for (const Retired& retired : state.retired) {
+                retired.deleter(retired.ptr);
+            }
+            state.retired.clear();
+            return;
+        }
+        std::sort(hazards.begin(), hazards.end());
+        auto still_protected = std::partition(state.retired.begin(), state.retired.end(),
+                                              [&hazards](const Retired& retired) {
+                                                  return std::binary_search(hazards.begin(), hazards.end(),
+                                                                            retired.ptr);
+                                              });
+        for (auto it = still_protected; it != state.retired.end(); ++it) {
+            it->deleter(it->ptr);
+        }
+        state.retired.erase(still_protected, state.retired.end());
+    }
+};
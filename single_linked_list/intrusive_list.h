@@ -0,0 +1,216 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+// Звено для встраивания в объект: объект с несколькими звеньями может одновременно
+// состоять в нескольких списках
+template <typename Type>
+struct IntrusiveListHook {
+    Type* next_node = nullptr;
+};
+
+// Односвязный список из готовых объектов, связанных через их член Hook. Список не владеет объектами:
+// не создаёт, не копирует и не разрушает их, а вставка и удаление не выделяют память.
+// Объект должен жить, пока он в списке, и состоять не больше чем в одном списке через одно звено.
+// Итераторы и операции - как у SingleLinkedList, только вставляется сам объект, а не его копия
+template <typename Type, IntrusiveListHook<Type> Type::*Hook>
+class IntrusiveSingleLinkedList {
+    using HookType = IntrusiveListHook<Type>;
+
+    template <typename ValueType>
+    class BasicIterator {
+        friend class IntrusiveSingleLinkedList;
+        template <typename OtherValueType>
+        friend class BasicIterator;
+
+        // Позиция перед первым элементом - звено головы без объекта
+        BasicIterator(HookType* hook, Type* object) noexcept
+            : hook_(hook)
+            , object_(object) {
+        }
+
+        explicit BasicIterator(Type* object) noexcept
+            : hook_(object != nullptr ? &(object->*Hook) : nullptr)
+            , object_(object) {
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = ValueType*;
+        using reference = ValueType&;
+
+        BasicIterator() = default;
+
+        BasicIterator(const BasicIterator<Type>& other) noexcept
+            : hook_(other.hook_)
+            , object_(other.object_) {
+        }
+
+        BasicIterator& operator=(const BasicIterator& rhs) = default;
+
+        [[nodiscard]] bool operator==(const BasicIterator<const Type>& rhs) const noexcept {
+            return hook_ == rhs.hook_;
+        }
+
+        [[nodiscard]] bool operator!=(const BasicIterator<const Type>& rhs) const noexcept {
+            return hook_ != rhs.hook_;
+        }
+
+        [[nodiscard]] bool operator==(const BasicIterator<Type>& rhs) const noexcept {
+            return hook_ == rhs.hook_;
+        }
+
+        [[nodiscard]] bool operator!=(const BasicIterator<Type>& rhs) const noexcept {
+            return hook_ != rhs.hook_;
+        }
+
+        BasicIterator& operator++() noexcept {
+            assert(hook_ != nullptr);
+            *this = BasicIterator(hook_->next_node);
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            auto old_value(*this);
+            ++(*this);
+            return old_value;
+        }
+
+        [[nodiscard]] reference operator*() const noexcept {
+            assert(object_ != nullptr);
+            return *object_;
+        }
+
+        [[nodiscard]] pointer operator->() const noexcept {
+            assert(object_ != nullptr);
+            return object_;
+        }
+
+    private:
+        HookType* hook_ = nullptr;
+        Type* object_ = nullptr;
+    };
+
+public:
+    using value_type = Type;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using Iterator = BasicIterator<Type>;
+    using ConstIterator = BasicIterator<const Type>;
+
+    IntrusiveSingleLinkedList() = default;
+
+    // Одно звено не может связывать объект с двумя списками, поэтому список не копируется
+    IntrusiveSingleLinkedList(const IntrusiveSingleLinkedList&) = delete;
+    IntrusiveSingleLinkedList& operator=(const IntrusiveSingleLinkedList&) = delete;
+
+    IntrusiveSingleLinkedList(IntrusiveSingleLinkedList&& other) noexcept {
+        swap(other);
+    }
+
+    IntrusiveSingleLinkedList& operator=(IntrusiveSingleLinkedList&& rhs) noexcept {
+        if (this != &rhs) {
+            Clear();
+            swap(rhs);
+        }
+        return *this;
+    }
+
+    void swap(IntrusiveSingleLinkedList& other) noexcept {
+        std::swap(size_, other.size_);
+        std::swap(head_.next_node, other.head_.next_node);
+    }
+
+    [[nodiscard]] size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    [[nodiscard]] bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    void PushFront(Type& object) noexcept {
+        InsertAfter(cbefore_begin(), object);
+    }
+
+    void PopFront() noexcept {
+        assert(size_ != 0);
+        EraseAfter(cbefore_begin());
+    }
+
+    // Отцепляет все объекты за O(1); сами объекты не трогаются
+    void Clear() noexcept {
+        head_.next_node = nullptr;
+        size_ = 0;
+    }
+
+    [[nodiscard]] Iterator begin() noexcept {
+        return Iterator{head_.next_node};
+    }
+
+    [[nodiscard]] Iterator end() noexcept {
+        return Iterator{nullptr, nullptr};
+    }
+
+    [[nodiscard]] ConstIterator begin() const noexcept {
+        return ConstIterator{head_.next_node};
+    }
+
+    [[nodiscard]] ConstIterator end() const noexcept {
+        return ConstIterator{nullptr, nullptr};
+    }
+
+    [[nodiscard]] ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    [[nodiscard]] ConstIterator cend() const noexcept {
+        return end();
+    }
+
+    [[nodiscard]] Iterator before_begin() noexcept {
+        return Iterator{&head_, nullptr};
+    }
+
+    [[nodiscard]] ConstIterator before_begin() const noexcept {
+        return ConstIterator{const_cast<HookType*>(&head_), nullptr};
+    }
+
+    [[nodiscard]] ConstIterator cbefore_begin() const noexcept {
+        return before_begin();
+    }
+
+    // Вставляет сам объект; он не должен уже быть в списке через то же звено
+    Iterator InsertAfter(ConstIterator pos, Type& object) noexcept {
+        assert(pos.hook_ != nullptr);
+        HookType& hook = object.*Hook;
+        hook.next_node = pos.hook_->next_node;
+        pos.hook_->next_node = &object;
+        ++size_;
+        return Iterator{&object};
+    }
+
+    // Отцепляет объект после pos; звено объекта обнуляется, сам объект не разрушается
+    Iterator EraseAfter(ConstIterator pos) noexcept {
+        assert(pos.hook_ != nullptr && pos.hook_->next_node != nullptr);
+        HookType& erased = pos.hook_->next_node->*Hook;
+        pos.hook_->next_node = std::exchange(erased.next_node, nullptr);
+        --size_;
+        return Iterator{pos.hook_->next_node};
+    }
+
+private:
+    // Звено головы, используется для вставки "перед первым элементом"
+    HookType head_;
+    size_t size_ = 0;
+};
+
+template <typename Type, IntrusiveListHook<Type> Type::*Hook>
+void swap(IntrusiveSingleLinkedList<Type, Hook>& lhs, IntrusiveSingleLinkedList<Type, Hook>& rhs) noexcept {
+    lhs.swap(rhs);
+}
@@ -0,0 +1,295 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <utility>
+#include <vector>
+#include "hazard_pointers.h"
+
+// Узел односвязного списка для структур без блокировок: ссылка на следующий узел атомарна,
+// а элемент создаётся и разрушается отдельно от узла, потому что очередь держит узел-заглушку
+// без элемента, а стек отдаёт элемент раньше, чем освобождается память узла
+template <typename Type>
+struct LockFreeNode {
+    LockFreeNode() = default;
+
+    template <typename... Args>
+    explicit LockFreeNode(std::in_place_t, Args&&... args) {
+        new (storage) Type(std::forward<Args>(args)...);
+    }
+
+    Type& Value() noexcept {
+        return *std::launder(reinterpret_cast<Type*>(storage));
+    }
+
+    // Забирает элемент из узла; сам узел остаётся
+    Type TakeValue() {
+        Type value(std::move(Value()));
+        std::destroy_at(&Value());
+        return value;
+    }
+
+    // Узел с элементом из args: из кэша освобождённых узлов потока или из кучи
+    template <typename... Args>
+    static LockFreeNode* Create(Args&&... args) {
+        std::vector<LockFreeNode*>& nodes = GetCache().nodes;
+        if (nodes.empty()) {
+            return new LockFreeNode(std::in_place, std::forward<Args>(args)...);
+        }
+        LockFreeNode* node = nodes.back();
+        new (node->storage) Type(std::forward<Args>(args)...);
+        nodes.pop_back();
+        node->next_node.store(nullptr, std::memory_order_relaxed);
+        return node;
+    }
+
+    // Возвращает узел без элемента в кэш потока. Подходит как deleter для HazardPointers::Retire:
+    // опасные указатели освобождают узлы пачками, и без кэша каждая пачка превращалась бы в пачку
+    // free, которая не помещается в собственный кэш malloc потока
+    static void Recycle(void* ptr) noexcept {
+        auto* node = static_cast<LockFreeNode*>(ptr);
+        // Кэш, уже разрушенный при завершении потока, не трогаем - узел просто удаляется.
+        // Место в кэше зарезервировано заранее, поэтому push_back не выделяет память
+        if (GetCacheState() == CacheState::DESTROYED) {
+            delete node;
+            return;
+        }
+        std::vector<LockFreeNode*>& nodes = GetCache().nodes;
+        if (nodes.size() == nodes.capacity()) {
+            delete node;
+            return;
+        }
+        nodes.push_back(node);
+    }
+
+    std::atomic<LockFreeNode*> next_node{nullptr};
+    alignas(Type) unsigned char storage[sizeof(Type)];
+
+private:
+    // Хватает, чтобы пережить пачку освобождения при любом разумном числе потоков
+    static constexpr size_t MAX_CACHED_NODES = 1024;
+
+    enum class CacheState {
+        NONE,
+        ALIVE,
+        DESTROYED,
+    };
+
+    struct Cache {
+        // Если памяти под кэш не нашлось, кэш остаётся пустым, и узлы удаляются сразу
+        Cache() noexcept {
+            try {
+                nodes.reserve(MAX_CACHED_NODES);
+            } catch (const std::bad_alloc&) {
+            }
+            GetCacheState() = CacheState::ALIVE;
+        }
+
+        ~Cache() {
+            GetCacheState() = CacheState::DESTROYED;
+            for (LockFreeNode* node : nodes) {
+                delete node;
+            }
+        }
+
+        std::vector<LockFreeNode*> nodes;
+    };
+
+    static Cache& GetCache() {
+        thread_local Cache cache;
+        return cache;
+    }
+
+    // Тривиальное состояние можно читать и после разрушения кэша при завершении потока
+    static CacheState& GetCacheState() noexcept {
+        thread_local CacheState state = CacheState::NONE;
+        return state;
+    }
+};
+
+// Стек Трайбера: вершина меняется одним CAS, потоки не ждут друг друга.
+// Снятый узел освобождается через HazardPointers, когда его больше никто не читает, и попадает
+// в кэш узлов потока, из которого берут узлы следующие Push.
+// Разрушать стек можно только после завершения всех операций с ним
+template <typename Type>
+class LockFreeStack {
+    using Node = LockFreeNode<Type>;
+
+public:
+    LockFreeStack() noexcept = default;
+
+    LockFreeStack(const LockFreeStack&) = delete;
+    LockFreeStack& operator=(const LockFreeStack&) = delete;
+
+    ~LockFreeStack() {
+        Node* node = head_.load(std::memory_order_acquire);
+        while (node != nullptr) {
+            Node* next = node->next_node.load(std::memory_order_relaxed);
+            std::destroy_at(&node->Value());
+            delete node;
+            node = next;
+        }
+    }
+
+    void Push(const Type& value) {
+        Emplace(value);
+    }
+
+    void Push(Type&& value) {
+        Emplace(std::move(value));
+    }
+
+    template <typename... Args>
+    void Emplace(Args&&... args) {
+        Node* node = Node::Create(std::forward<Args>(args)...);
+        PushChain(node, node);
+    }
+
+    // Снимает вершину; пустой optional, если стек пуст
+    std::optional<Type> TryPop() {
+        Node* top = nullptr;
+        while (true) {
+            top = HazardPointers::Protect(head_);
+            if (top == nullptr) {
+                HazardPointers::Clear();
+                return std::nullopt;
+            }
+            // Пока узел защищён, он не освобождён, и его ссылку можно читать
+            Node* next = top->next_node.load(std::memory_order_relaxed);
+            if (head_.compare_exchange_weak(top, next, std::memory_order_acquire, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        HazardPointers::Clear();
+        std::optional<Type> result(top->TakeValue());
+        HazardPointers::Retire(top, &Node::Recycle);
+        return result;
+    }
+
+    // Забирает все элементы одним обменом вершины и передаёт их consumer от вершины ко дну.
+    // Возвращает число переданных элементов. Если consumer бросит исключение,
+    // текущий элемент теряется, а ещё не переданные возвращаются в стек
+    template <typename Consumer>
+    size_t PopAll(Consumer consumer) {
+        Node* node = head_.exchange(nullptr, std::memory_order_acquire);
+        size_t count = 0;
+        while (node != nullptr) {
+            Node* next = node->next_node.load(std::memory_order_relaxed);
+            try {
+                consumer(node->TakeValue());
+            } catch (...) {
+                HazardPointers::Retire(node, &Node::Recycle);
+                if (next != nullptr) {
+                    Node* last = next;
+                    while (Node* after = last->next_node.load(std::memory_order_relaxed)) {
+                        last = after;
+                    }
+                    PushChain(next, last);
+                }
+                throw;
+            }
+            // Узел мог быть защищён потоком, прочитавшим его до обмена, поэтому тоже через Retire
+            HazardPointers::Retire(node, &Node::Recycle);
+            node = next;
+            ++count;
+        }
+        return count;
+    }
+
+    // Снимок: к моменту использования результата стек мог измениться
+    bool IsEmpty() const noexcept {
+        return head_.load(std::memory_order_relaxed) == nullptr;
+    }
+
+private:
+    // Кладёт готовую цепочку first..last на вершину
+    void PushChain(Node* first, Node* last) noexcept {
+        Node* head = head_.load(std::memory_order_relaxed);
+        do {
+            last->next_node.store(head, std::memory_order_relaxed);
+        } while (!head_.compare_exchange_weak(head, first, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    alignas(64) std::atomic<Node*> head_{nullptr};
+};
+
+// Очередь со многими производителями и одним потребителем на тех же узлах (очередь Вьюкова).
+// Производитель занимает место в хвосте одним обменом и затем дописывает ссылку из предыдущего узла.
+// Узлы освобождает только потребитель и только после того, как производитель записал в них ссылку,
+// поэтому опасные указатели здесь не нужны. Производитель, остановленный между обменом и записью
+// ссылки, задерживает для потребителя свой элемент и все следующие; остальные производители не ждут.
+// Push можно вызывать из любых потоков, TryPop и PopAll - только из одного
+template <typename Type>
+class MpscQueue {
+    using Node = LockFreeNode<Type>;
+
+public:
+    // Заглушка без элемента: голова очереди всегда указывает на уже прочитанный узел
+    MpscQueue()
+        : head_(new Node)
+        , tail_(head_) {
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    ~MpscQueue() {
+        Node* next = head_->next_node.load(std::memory_order_acquire);
+        Node::Recycle(head_);
+        while (next != nullptr) {
+            Node* node = next;
+            next = node->next_node.load(std::memory_order_acquire);
+            std::destroy_at(&node->Value());
+            Node::Recycle(node);
+        }
+    }
+
+    void Push(const Type& value) {
+        Emplace(value);
+    }
+
+    void Push(Type&& value) {
+        Emplace(std::move(value));
+    }
+
+    // Узлы берутся из кэша потока и возвращаются в кэш потребителя: повторно их используют
+    // элементы, которые потребитель добавляет сам, другим производителям они достаются из кучи
+    template <typename... Args>
+    void Emplace(Args&&... args) {
+        Node* node = Node::Create(std::forward<Args>(args)...);
+        Node* prev = tail_.exchange(node, std::memory_order_acq_rel);
+        prev->next_node.store(node, std::memory_order_release);
+    }
+
+    // Пустой optional, если очередь пуста или следующий элемент ещё не дописан
+    std::optional<Type> TryPop() {
+        Node* next = head_->next_node.load(std::memory_order_acquire);
+        if (next == nullptr) {
+            return std::nullopt;
+        }
+        std::optional<Type> result(next->TakeValue());
+        Node::Recycle(std::exchange(head_, next));
+        return result;
+    }
+
+    // Передаёт consumer все уже дописанные элементы в порядке добавления и возвращает их число
+    template <typename Consumer>
+    size_t PopAll(Consumer consumer) {
+        size_t count = 0;
+        while (Node* next = head_->next_node.load(std::memory_order_acquire)) {
+            Type value = next->TakeValue();
+            Node::Recycle(std::exchange(head_, next));
+            ++count;
+            consumer(std::move(value));
+        }
+        return count;
+    }
+
+private:
+    // Голова нужна только потребителю, хвост - производителям: разносим по разным кеш-линиям
+    alignas(64) Node* head_;
+    alignas(64) std::atomic<Node*> tail_;
+};
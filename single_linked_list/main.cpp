@@ -1,6 +1,22 @@
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
+#include "intrusive_list.h"
+#include "lock_free_list.h"
+#include "node_pool.h"
 #include "single-linked-list.h"
+#include "unrolled_list.h"
 
 // Эта функция проверяет работу класса SingleLinkedList
 void Test() {
@@ -145,6 +161,777 @@ void Test() {
     }
 }
 
+// Аллокатор без конструктора по умолчанию, считает свои выделения
+template <typename Type>
+struct CountingAllocator {
+    using value_type = Type;
+
+    explicit CountingAllocator(int* allocations) noexcept
+        : allocations(allocations) {
+    }
+
+    template <typename Other>
+    CountingAllocator(const CountingAllocator<Other>& other) noexcept
+        : allocations(other.allocations) {
+    }
+
+    Type* allocate(size_t count) {
+        ++*allocations;
+        return std::allocator<Type>().allocate(count);
+    }
+
+    void deallocate(Type* ptr, size_t count) noexcept {
+        --*allocations;
+        std::allocator<Type>().deallocate(ptr, count);
+    }
+
+    template <typename Other>
+    bool operator==(const CountingAllocator<Other>& other) const noexcept {
+        return allocations == other.allocations;
+    }
+
+    template <typename Other>
+    bool operator!=(const CountingAllocator<Other>& other) const noexcept {
+        return !(*this == other);
+    }
+
+    int* allocations;
+};
+
+// Проверка списка с пулом узлов
+void TestPoolAllocator() {
+    using Pool = PoolAllocator<int, 4>;
+
+    // Освобождённые узлы переиспользуются, Clear возвращает блоки
+    {
+        Pool alloc;
+        SingleLinkedList<int, Pool> list(alloc);
+        for (int i = 0; i < 10; ++i) {
+            list.PushFront(i);
+        }
+        assert(list.GetSize() == 10u);
+        assert(*list.begin() == 9);
+        list.PopFront();
+        list.EraseAfter(list.cbegin());
+        assert(list.GetSize() == 8u);
+        assert((list == SingleLinkedList<int, Pool>{8, 6, 5, 4, 3, 2, 1, 0}));
+        list.PushFront(100);
+        list.InsertAfter(list.cbegin(), 200);
+        assert((list == SingleLinkedList<int, Pool>{100, 200, 8, 6, 5, 4, 3, 2, 1, 0}));
+        // Аллокатор списка - перепривязанная копия alloc, пул у них общий
+        assert(alloc.GetAllocatedCount() == 10u && alloc.GetBlockCount() == 3u);
+        list.Clear();
+        assert(list.IsEmpty());
+        assert(alloc.GetAllocatedCount() == 0u && alloc.GetBlockCount() == 0u);
+        list.PushFront(1);
+        assert(*list.begin() == 1 && alloc.GetBlockCount() == 1u);
+    }
+
+    // Сам пул: куски по одному из блоков, повторная выдача и освобождение блоков
+    {
+        Pool alloc;
+        int* first = alloc.allocate(1);
+        int* second = alloc.allocate(1);
+        assert(alloc.GetAllocatedCount() == 2u);
+        assert(alloc.GetBlockCount() == 1u);
+        // Кусок не меньше указателя, которым связан список свободных
+        assert(reinterpret_cast<char*>(second) - reinterpret_cast<char*>(first) == sizeof(void*));
+        alloc.deallocate(first, 1);
+        assert(alloc.allocate(1) == first);
+        for (int i = 0; i < 3; ++i) {
+            alloc.allocate(1);
+        }
+        assert(alloc.GetBlockCount() == 2u);
+        Pool copy = alloc;
+        assert(copy == alloc && copy.GetAllocatedCount() == 5u);
+        assert(Pool() != alloc);
+        alloc.Release();
+        assert(copy.GetBlockCount() == 0u && copy.GetAllocatedCount() == 0u);
+    }
+
+    // Элементы с нетривиальным деструктором разрушаются, копия списка получает свой пул
+    {
+        using StringPool = PoolAllocator<std::string, 2>;
+        SingleLinkedList<std::string, StringPool> list{"a string that does not fit into SSO", "b", "c"};
+        SingleLinkedList<std::string, StringPool> copy(list);
+        assert(copy == list);
+        list.Clear();
+        assert(list.IsEmpty() && copy.GetSize() == 3u);
+        list = copy;
+        copy.PopFront();
+        assert(*list.begin() == "a string that does not fit into SSO");
+        assert(*copy.begin() == "b");
+        swap(list, copy);
+        assert(list.GetSize() == 2u && copy.GetSize() == 3u);
+    }
+
+    // Копирование строит узлы аллокатором самого списка, не создавая аллокатор по умолчанию
+    {
+        int allocations = 0;
+        using List = SingleLinkedList<int, CountingAllocator<int>>;
+        CountingAllocator<int> alloc(&allocations);
+        {
+            List list({1, 2, 3}, alloc);
+            List copy(list);
+            std::vector<int> values{4, 5};
+            List from_range(values.begin(), values.end(), alloc);
+            assert(copy == list && from_range.GetSize() == 2u);
+            assert(allocations == 8);
+        }
+        assert(allocations == 0);
+    }
+}
+
+// Проверка развёрнутого списка
+void TestUnrolledList() {
+    using List = UnrolledList<int, 4>;
+
+    // Те же операции, что и у SingleLinkedList
+    {
+        List empty;
+        assert(empty.IsEmpty() && empty.begin() == empty.end());
+        assert(++empty.before_begin() == empty.begin());
+        assert(empty.before_begin() == empty.cbefore_begin());
+
+        List numbers{3, 14, 15, 92, 6};
+        numbers.PopFront();
+        assert((numbers == List{14, 15, 92, 6}));
+        auto inserted = numbers.InsertAfter(numbers.cbefore_begin(), 1);
+        assert(inserted == numbers.begin() && *inserted == 1);
+        auto after_erased = numbers.EraseAfter(numbers.cbegin());
+        assert(*after_erased == 15);
+        assert((numbers == List{1, 15, 92, 6}));
+        List copy = numbers;
+        copy.PushFront(0);
+        assert(copy.GetSize() == 5u && numbers.GetSize() == 4u);
+        numbers = copy;
+        assert(numbers == copy);
+
+        List moved(std::move(copy));
+        assert(moved == numbers && copy.IsEmpty() && copy.begin() == copy.end());
+        copy = std::move(moved);
+        assert(copy == numbers && moved.IsEmpty());
+        moved.PushFront(7);
+        assert(*moved.begin() == 7 && moved.GetSize() == 1u);
+        static_assert(std::is_nothrow_move_constructible_v<List> && std::is_nothrow_move_assignable_v<List>);
+    }
+
+    // Деление полных узлов и слияние полупустых на случайных вставках и удалениях
+    {
+        List list;
+        std::vector<int> model;
+        std::mt19937 generator(42);
+        for (int step = 0; step < 20000; ++step) {
+            size_t position = model.empty() ? 0 : generator() % (model.size() + 1);
+            bool insert = model.size() < 50 ? generator() % 3 != 0 : generator() % 3 == 0;
+            auto pos = list.cbefore_begin();
+            for (size_t i = 0; i < position; ++i) {
+                ++pos;
+            }
+            if (insert || model.empty()) {
+                auto it = list.InsertAfter(pos, step);
+                assert(*it == step);
+                model.insert(model.begin() + position, step);
+            } else {
+                if (position == model.size()) {
+                    --position;
+                    pos = list.cbefore_begin();
+                    for (size_t i = 0; i < position; ++i) {
+                        ++pos;
+                    }
+                }
+                auto it = list.EraseAfter(pos);
+                model.erase(model.begin() + position);
+                assert(position == model.size() ? it == list.end() : *it == model[position]);
+            }
+            assert(list.GetSize() == model.size());
+        }
+        assert(std::equal(list.begin(), list.end(), model.begin(), model.end()));
+        while (!list.IsEmpty()) {
+            list.PopFront();
+        }
+        assert(list.begin() == list.end());
+    }
+
+    // Все элементы разрушаются, а брошенное при копировании исключение не меняет список
+    {
+        struct DeletionSpy {
+            ~DeletionSpy() {
+                if (deletion_counter_ptr) {
+                    ++(*deletion_counter_ptr);
+                }
+            }
+            int* deletion_counter_ptr = nullptr;
+        };
+        int deletion_counter = 0;
+        {
+            UnrolledList<DeletionSpy, 2> list;
+            for (int i = 0; i < 5; ++i) {
+                list.PushFront(DeletionSpy{});
+            }
+            for (DeletionSpy& spy : list) {
+                spy.deletion_counter_ptr = &deletion_counter;
+            }
+            list.EraseAfter(list.cbegin());
+            assert(deletion_counter == 1);
+        }
+        assert(deletion_counter == 5);
+
+        struct ThrowOnCopy {
+            ThrowOnCopy() = default;
+            ThrowOnCopy(const ThrowOnCopy& other)
+                : fail(other.fail) {
+                if (fail) {
+                    throw std::bad_alloc();
+                }
+            }
+            ThrowOnCopy& operator=(const ThrowOnCopy&) = default;
+            bool fail = false;
+        };
+        UnrolledList<ThrowOnCopy, 2> list{ThrowOnCopy{}, ThrowOnCopy{}, ThrowOnCopy{}, ThrowOnCopy{}};
+        ThrowOnCopy bomb;
+        bomb.fail = true;
+        for (auto pos = list.cbefore_begin(); pos != list.cend(); ++pos) {
+            try {
+                list.InsertAfter(pos, bomb);
+                assert(false);
+            } catch (const std::bad_alloc&) {
+                assert(list.GetSize() == 4u);
+            }
+        }
+        UnrolledList<ThrowOnCopy, 2> empty;
+        try {
+            empty.PushFront(bomb);
+            assert(false);
+        } catch (const std::bad_alloc&) {
+            assert(empty.IsEmpty() && empty.begin() == empty.end());
+        }
+    }
+
+    // Исключение при переносе половины узла в новый узел не теряет ни новый узел, ни элементы
+    {
+        // Сколько ещё копирований удастся; -1 - без ограничений
+        int budget = -1;
+        struct Fragile {
+            Fragile(int value, int* budget)
+                : value(value)
+                , budget(budget) {
+            }
+            Fragile(const Fragile& other)
+                : value(other.value)
+                , budget(other.budget) {
+                if (*budget != -1 && (*budget)-- == 0) {
+                    throw std::bad_alloc();
+                }
+            }
+            Fragile(Fragile&& other)
+                : Fragile(static_cast<const Fragile&>(other)) {
+            }
+            Fragile& operator=(const Fragile&) = default;
+            Fragile& operator=(Fragile&&) = default;
+            int value;
+            int* budget;
+        };
+        UnrolledList<Fragile, 2> list{Fragile(1, &budget), Fragile(2, &budget)};
+        // Первое копирование - вставляемое значение, второе - перенос при делении узла
+        budget = 1;
+        try {
+            list.InsertAfter(list.cbegin(), Fragile(3, &budget));
+            assert(false);
+        } catch (const std::bad_alloc&) {
+        }
+        budget = -1;
+        assert(list.GetSize() == 2u && list.begin()->value == 1 && std::next(list.begin())->value == 2);
+        list.InsertAfter(list.cbegin(), Fragile(3, &budget));
+        assert(list.GetSize() == 3u && std::next(list.begin())->value == 3);
+    }
+
+    // Исключение при сдвиге хвоста узла не теряет элемент, созданный за концом узла
+    {
+        int alive = 0;
+        int assignments_left = -1;
+        struct Shifted {
+            Shifted(int* alive, int* assignments_left)
+                : alive(alive)
+                , assignments_left(assignments_left) {
+                ++*alive;
+            }
+            Shifted(const Shifted& other)
+                : Shifted(other.alive, other.assignments_left) {
+            }
+            Shifted& operator=(const Shifted&) {
+                if (*assignments_left != -1 && (*assignments_left)-- == 0) {
+                    throw std::bad_alloc();
+                }
+                return *this;
+            }
+            ~Shifted() {
+                --*alive;
+            }
+            int* alive;
+            int* assignments_left;
+        };
+        {
+            Shifted sample(&alive, &assignments_left);
+            UnrolledList<Shifted, 4> list{sample, sample, sample};
+            for (int budget : {0, 1}) {
+                assignments_left = budget;
+                try {
+                    list.PushFront(sample);
+                    assert(false);
+                } catch (const std::bad_alloc&) {
+                }
+                assignments_left = -1;
+                assert(alive == static_cast<int>(list.GetSize()) + 1);
+                assert(std::distance(list.begin(), list.end()) == static_cast<std::ptrdiff_t>(list.GetSize()));
+                list.PopFront();
+            }
+        }
+        assert(alive == 0);
+    }
+}
+
+// Тип, который считает свои копирования
+struct CopyCounter {
+    CopyCounter(int value, int* copies)
+        : value(value)
+        , copies(copies) {
+    }
+    CopyCounter(const CopyCounter& other)
+        : value(other.value)
+        , copies(other.copies) {
+        ++*copies;
+    }
+    CopyCounter(CopyCounter&& other) noexcept = default;
+    CopyCounter& operator=(const CopyCounter&) = default;
+    int value;
+    int* copies;
+};
+
+// Проверка перемещения списков и создания элементов на месте
+void TestMoveSemantics() {
+
+    // Временные значения и аргументы конструктора не копируются
+    {
+        int copies = 0;
+        SingleLinkedList<CopyCounter> list;
+        list.PushFront(CopyCounter(1, &copies));
+        CopyCounter& front = list.EmplaceFront(0, &copies);
+        assert(&front == &*list.begin());
+        auto it = list.EmplaceAfter(list.cbegin(), 5, &copies);
+        assert(it->value == 5);
+        list.InsertAfter(it, CopyCounter(7, &copies));
+        assert(copies == 0);
+        CopyCounter lvalue(9, &copies);
+        list.PushFront(lvalue);
+        assert(copies == 1 && list.GetSize() == 5u);
+    }
+
+    // Типы только с перемещением
+    {
+        SingleLinkedList<std::unique_ptr<int>> list;
+        list.PushFront(std::make_unique<int>(2));
+        list.EmplaceFront(new int(1));
+        list.InsertAfter(list.cbegin(), std::make_unique<int>(3));
+        assert(**list.begin() == 1 && **++list.begin() == 3);
+        list.EraseAfter(list.cbegin());
+        assert(list.GetSize() == 2u);
+    }
+
+    // Перемещение за O(1): узлы переходят к новому списку без копирования
+    {
+        SingleLinkedList<int> source{1, 2, 3};
+        const int* first = &*source.begin();
+        SingleLinkedList<int> moved(std::move(source));
+        assert(&*moved.begin() == first);
+        assert(moved.GetSize() == 3u);
+        assert(source.IsEmpty() && source.begin() == source.end());
+        source.PushFront(10);
+        assert(source.GetSize() == 1u);
+
+        SingleLinkedList<int> target{7, 8};
+        target = std::move(moved);
+        assert(&*target.begin() == first);
+        assert((target == SingleLinkedList<int>{1, 2, 3}));
+        assert(moved.IsEmpty());
+        target = std::move(target);
+        assert(target.GetSize() == 3u);
+        static_assert(std::is_nothrow_move_constructible_v<SingleLinkedList<int>>);
+        static_assert(std::is_nothrow_move_assignable_v<SingleLinkedList<int>>);
+    }
+
+    // С пулом узлов аллокатор переходит вместе с узлами
+    {
+        using Pool = PoolAllocator<std::string>;
+        SingleLinkedList<std::string, Pool> source{"a", "b"};
+        SingleLinkedList<std::string, Pool> target{"c"};
+        target = std::move(source);
+        assert((target == SingleLinkedList<std::string, Pool>{"a", "b"}));
+        SingleLinkedList<std::string, Pool> moved(std::move(target));
+        moved.EmplaceFront(3, 'x');
+        assert(*moved.begin() == "xxx" && moved.GetSize() == 3u);
+        static_assert(std::is_nothrow_move_assignable_v<SingleLinkedList<std::string, Pool>>);
+    }
+}
+
+// Проверка построения из диапазона и перестановки узлов
+void TestSpliceMergeSort() {
+    using List = SingleLinkedList<int>;
+
+    // Каждый элемент копируется ровно один раз, подходит любой входной итератор
+    {
+        int copies = 0;
+        std::vector<CopyCounter> values;
+        for (int i = 0; i < 5; ++i) {
+            values.emplace_back(i, &copies);
+        }
+        SingleLinkedList<CopyCounter> list(values.begin(), values.end());
+        assert(copies == 5 && list.GetSize() == 5u);
+        SingleLinkedList<CopyCounter> copy(list);
+        assert(copies == 10 && copy.begin()->value == 0);
+
+        std::istringstream input("4 8 15 16 23 42");
+        List numbers{std::istream_iterator<int>(input), std::istream_iterator<int>()};
+        assert((numbers == List{4, 8, 15, 16, 23, 42}));
+        const std::vector<int> replacement{7, 8};
+        numbers.Copy(replacement.begin(), replacement.end());
+        assert((numbers == List{7, 8}) && numbers.GetSize() == 2u);
+    }
+
+    // Перенос узлов между списками: элементы остаются по тем же адресам
+    {
+        List to{1, 2};
+        List from{10, 20, 30, 40};
+        const int* twenty = &*++from.begin();
+        to.SpliceAfter(to.cbegin(), from, from.cbegin());
+        assert((to == List{1, 20, 2}) && &*++to.begin() == twenty);
+        assert((from == List{10, 30, 40}) && from.GetSize() == 3u);
+
+        to.SpliceAfter(to.cbefore_begin(), from, from.cbefore_begin(), ++from.cbegin());
+        assert((to == List{10, 1, 20, 2}) && to.GetSize() == 4u);
+        assert((from == List{30, 40}) && from.GetSize() == 2u);
+
+        to.SpliceAfter(to.cbegin(), from);
+        assert((to == List{10, 30, 40, 1, 20, 2}) && to.GetSize() == 6u);
+        assert(from.IsEmpty() && from.begin() == from.end());
+
+        // Перестановка внутри одного списка
+        to.SpliceAfter(to.cbefore_begin(), to, ++++to.cbegin(), to.cend());
+        assert((to == List{1, 20, 2, 10, 30, 40}) && to.GetSize() == 6u);
+    }
+
+    // Устойчивое слияние отсортированных списков
+    {
+        using Pair = std::pair<int, char>;
+        auto by_key = [](const Pair& lhs, const Pair& rhs) {
+            return lhs.first < rhs.first;
+        };
+        SingleLinkedList<Pair> left{{1, 'a'}, {3, 'a'}, {5, 'a'}};
+        SingleLinkedList<Pair> right{{1, 'b'}, {2, 'b'}, {5, 'b'}, {7, 'b'}};
+        left.Merge(right, by_key);
+        assert((left == SingleLinkedList<Pair>{{1, 'a'}, {1, 'b'}, {2, 'b'}, {3, 'a'}, {5, 'a'}, {5, 'b'}, {7, 'b'}}));
+        assert(left.GetSize() == 7u && right.IsEmpty());
+
+        List numbers{1, 4};
+        List empty;
+        numbers.Merge(empty);
+        empty.Merge(numbers);
+        assert((empty == List{1, 4}) && numbers.IsEmpty());
+    }
+
+    // Сортировка совпадает с std::stable_sort
+    {
+        std::mt19937 generator(7);
+        for (size_t size : {0u, 1u, 2u, 3u, 17u, 1000u}) {
+            std::vector<std::pair<int, int>> model;
+            for (size_t i = 0; i < size; ++i) {
+                model.emplace_back(static_cast<int>(generator() % 50), static_cast<int>(i));
+            }
+            SingleLinkedList<std::pair<int, int>> list(model.begin(), model.end());
+            auto by_key = [](const auto& lhs, const auto& rhs) {
+                return lhs.first < rhs.first;
+            };
+            list.Sort(by_key);
+            std::stable_sort(model.begin(), model.end(), by_key);
+            assert(list.GetSize() == size);
+            assert(std::equal(list.begin(), list.end(), model.begin(), model.end()));
+        }
+        List numbers{5, 3, 9, 1};
+        numbers.Sort();
+        assert((numbers == List{1, 3, 5, 9}));
+        numbers.Sort(std::greater<>());
+        assert((numbers == List{9, 5, 3, 1}));
+    }
+
+    // Брошенное сравнением исключение не теряет узлы
+    {
+        List numbers;
+        for (int i = 0; i < 100; ++i) {
+            numbers.PushFront(i);
+        }
+        int comparisons = 0;
+        try {
+            numbers.Sort([&comparisons](int lhs, int rhs) {
+                if (++comparisons == 150) {
+                    throw std::runtime_error("comparison failed");
+                }
+                return lhs < rhs;
+            });
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        std::vector<int> rest(numbers.begin(), numbers.end());
+        assert(rest.size() == 100u && numbers.GetSize() == 100u);
+        std::sort(rest.begin(), rest.end());
+        for (int i = 0; i < 100; ++i) {
+            assert(rest[i] == i);
+        }
+
+        List left{1, 3, 5};
+        List right{2, 4, 6};
+        comparisons = 0;
+        try {
+            left.Merge(right, [&comparisons](int lhs, int rhs) {
+                if (++comparisons == 3) {
+                    throw std::runtime_error("comparison failed");
+                }
+                return lhs < rhs;
+            });
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        rest.assign(left.begin(), left.end());
+        assert(rest.size() == 6u && left.GetSize() == 6u);
+        assert(right.IsEmpty() && right.GetSize() == 0u && right.begin() == right.end());
+        std::sort(rest.begin(), rest.end());
+        assert((rest == std::vector<int>{1, 2, 3, 4, 5, 6}));
+    }
+}
+
+// Проверка стека и очереди без блокировок
+void TestLockFreeList() {
+    // Порядок элементов в одном потоке
+    {
+        LockFreeStack<std::string> stack;
+        assert(stack.IsEmpty() && !stack.TryPop());
+        stack.Push("a");
+        stack.Emplace(3, 'b');
+        stack.Push(std::string("c"));
+        assert(*stack.TryPop() == "c");
+        std::vector<std::string> popped;
+        size_t count = stack.PopAll([&popped](std::string&& value) {
+            popped.push_back(std::move(value));
+        });
+        assert(count == 2u && (popped == std::vector<std::string>{"bbb", "a"}));
+        assert(stack.IsEmpty());
+
+        MpscQueue<std::unique_ptr<int>> queue;
+        assert(!queue.TryPop());
+        for (int i = 0; i < 5; ++i) {
+            queue.Emplace(new int(i));
+        }
+        assert(**queue.TryPop() == 0);
+        int expected = 1;
+        count = queue.PopAll([&expected](std::unique_ptr<int>&& value) {
+            assert(*value == expected++);
+        });
+        assert(count == 4u && !queue.TryPop());
+
+        // Следующие элементы создаются в узлах, которые вернулись в кэш потока
+        for (int round = 0; round < 3; ++round) {
+            for (int i = 0; i < 5; ++i) {
+                queue.Push(std::make_unique<int>(round * 10 + i));
+            }
+            expected = round * 10;
+            count = queue.PopAll([&expected](std::unique_ptr<int>&& value) {
+                assert(*value == expected++);
+            });
+            assert(count == 5u && !queue.TryPop());
+        }
+    }
+
+    // Оставшиеся элементы разрушаются вместе с контейнером
+    {
+        auto shared = std::make_shared<int>(0);
+        {
+            LockFreeStack<std::shared_ptr<int>> stack;
+            MpscQueue<std::shared_ptr<int>> queue;
+            for (int i = 0; i < 3; ++i) {
+                stack.Push(shared);
+                queue.Push(shared);
+            }
+            stack.TryPop();
+            queue.TryPop();
+            assert(shared.use_count() == 5);
+        }
+        assert(shared.use_count() == 1);
+    }
+
+    // Исключение в PopAll возвращает ещё не переданные элементы в стек
+    {
+        LockFreeStack<int> stack;
+        for (int i = 0; i < 5; ++i) {
+            stack.Push(i);
+        }
+        try {
+            stack.PopAll([](int value) {
+                if (value == 3) {
+                    throw std::runtime_error("consumer failed");
+                }
+            });
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        std::vector<int> rest;
+        stack.PopAll([&rest](int value) {
+            rest.push_back(value);
+        });
+        assert((rest == std::vector<int>{2, 1, 0}));
+    }
+
+    const int threads = 4;
+    const int per_thread = 20000;
+
+    // Каждый элемент снимается со стека ровно один раз
+    {
+        LockFreeStack<int> stack;
+        std::vector<std::atomic<int>> seen(threads * per_thread);
+        std::atomic<int> popped = 0;
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                for (int i = 0; i < per_thread; ++i) {
+                    stack.Push(t * per_thread + i);
+                    if (i % 2 == 1) {
+                        if (auto value = stack.TryPop()) {
+                            ++seen[*value];
+                            ++popped;
+                        }
+                    }
+                }
+                if (t == 0) {
+                    popped += static_cast<int>(stack.PopAll([&seen](int value) {
+                        ++seen[value];
+                    }));
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        while (auto value = stack.TryPop()) {
+            ++seen[*value];
+            ++popped;
+        }
+        assert(popped == threads * per_thread);
+        for (const auto& count : seen) {
+            assert(count == 1);
+        }
+    }
+
+    // Элементы каждого производителя приходят потребителю по порядку
+    {
+        MpscQueue<std::pair<int, int>> queue;
+        std::vector<std::thread> producers;
+        for (int t = 0; t < threads; ++t) {
+            producers.emplace_back([&queue, t] {
+                for (int i = 0; i < per_thread; ++i) {
+                    queue.Emplace(t, i);
+                }
+            });
+        }
+        std::vector<int> next(threads, 0);
+        int received = 0;
+        while (received < threads * per_thread) {
+            received += static_cast<int>(queue.PopAll([&next](std::pair<int, int>&& item) {
+                assert(item.second == next[item.first]);
+                ++next[item.first];
+            }));
+        }
+        for (auto& producer : producers) {
+            producer.join();
+        }
+        assert(!queue.TryPop());
+    }
+}
+
+// Проверка интрузивного списка
+void TestIntrusiveList() {
+    // Объект без копирования, который может быть сразу в двух списках
+    struct Task {
+        explicit Task(int id)
+            : id(id) {
+        }
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+
+        int id;
+        IntrusiveListHook<Task> ready_hook;
+        IntrusiveListHook<Task> all_hook;
+    };
+    using ReadyList = IntrusiveSingleLinkedList<Task, &Task::ready_hook>;
+    using AllList = IntrusiveSingleLinkedList<Task, &Task::all_hook>;
+
+    std::vector<std::unique_ptr<Task>> tasks;
+    for (int i = 0; i < 5; ++i) {
+        tasks.push_back(std::make_unique<Task>(i));
+    }
+    auto ids = [](const auto& list) {
+        std::vector<int> result;
+        for (const Task& task : list) {
+            result.push_back(task.id);
+        }
+        return result;
+    };
+
+    AllList all;
+    ReadyList ready;
+    assert(ready.IsEmpty() && ready.begin() == ready.end());
+    assert(++ready.before_begin() == ready.begin());
+    assert(ready.before_begin() == ready.cbefore_begin());
+
+    auto tail = all.cbefore_begin();
+    for (auto& task : tasks) {
+        tail = all.InsertAfter(tail, *task);
+    }
+    ready.PushFront(*tasks[3]);
+    auto inserted = ready.InsertAfter(ready.cbegin(), *tasks[1]);
+    assert(&*inserted == tasks[1].get());
+    ready.PushFront(*tasks[4]);
+    assert((ids(all) == std::vector<int>{0, 1, 2, 3, 4}));
+    assert((ids(ready) == std::vector<int>{4, 3, 1}));
+    assert(&*all.begin() == tasks[0].get() && ready.GetSize() == 3u);
+
+    // Удаление из одного списка не затрагивает другой
+    auto after_erased = ready.EraseAfter(ready.cbegin());
+    assert(&*after_erased == tasks[1].get());
+    assert((ids(ready) == std::vector<int>{4, 1}) && ready.GetSize() == 2u);
+    assert(tasks[3]->ready_hook.next_node == nullptr);
+    ready.PopFront();
+    assert((ids(ready) == std::vector<int>{1}));
+    all.EraseAfter(++all.cbegin());
+    assert((ids(all) == std::vector<int>{0, 1, 3, 4}) && all.GetSize() == 4u);
+
+    // Объект можно вернуть в список после удаления
+    ready.InsertAfter(ready.cbegin(), *tasks[3]);
+    assert((ids(ready) == std::vector<int>{1, 3}));
+
+    ReadyList moved(std::move(ready));
+    assert(ready.IsEmpty() && moved.GetSize() == 2u);
+    for (Task& task : moved) {
+        task.id *= 10;
+    }
+    assert((ids(all) == std::vector<int>{0, 10, 30, 4}));
+    moved.Clear();
+    assert(moved.IsEmpty() && moved.begin() == moved.end());
+}
+
 int main() {
     Test();
+    TestPoolAllocator();
+    TestUnrolledList();
+    TestMoveSemantics();
+    TestSpliceMergeSort();
+    TestLockFreeList();
+    TestIntrusiveList();
 }
@@ -0,0 +1,194 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Пул кусков одного размера: куски нарезаются из непрерывных блоков, освобождённые складываются
+// в список свободных и выдаются повторно. Размер куска задаёт первое выделение
+class NodePool {
+public:
+    explicit NodePool(size_t nodes_per_block) noexcept
+        : nodes_per_block_(nodes_per_block) {
+    }
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    ~NodePool() {
+        Release();
+    }
+
+    // Подходит ли пул для объектов такого размера и выравнивания
+    bool Fits(size_t size, size_t alignment) noexcept {
+        if (node_size_ == 0) {
+            node_alignment_ = std::max(alignment, alignof(FreeNode));
+            node_size_ = (std::max(size, sizeof(FreeNode)) + node_alignment_ - 1) / node_alignment_ * node_alignment_;
+        }
+        return size <= node_size_ && alignment <= node_alignment_;
+    }
+
+    void* Allocate() {
+        FreeNode* node = free_list_;
+        if (node != nullptr) {
+            free_list_ = node->next;
+        } else {
+            if (cursor_ == block_end_) {
+                AddBlock();
+            }
+            node = reinterpret_cast<FreeNode*>(cursor_);
+            cursor_ += node_size_;
+        }
+        ++allocated_;
+        return node;
+    }
+
+    void Deallocate(void* ptr) noexcept {
+        free_list_ = new (ptr) FreeNode{free_list_};
+        --allocated_;
+    }
+
+    size_t GetAllocatedCount() const noexcept {
+        return allocated_;
+    }
+
+    size_t GetBlockCount() const noexcept {
+        return blocks_.size();
+    }
+
+    void Release() noexcept {
+        for (char* block : blocks_) {
+            ::operator delete(block, std::align_val_t(node_alignment_));
+        }
+        blocks_.clear();
+        free_list_ = nullptr;
+        cursor_ = nullptr;
+        block_end_ = nullptr;
+        allocated_ = 0;
+    }
+
+private:
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    void AddBlock() {
+        blocks_.reserve(blocks_.size() + 1);
+        size_t block_size = node_size_ * nodes_per_block_;
+        char* block = static_cast<char*>(::operator new(block_size, std::align_val_t(node_alignment_)));
+        blocks_.push_back(block);
+        cursor_ = block;
+        block_end_ = block + block_size;
+    }
+
+    size_t nodes_per_block_;
+    size_t node_size_ = 0;
+    size_t node_alignment_ = 0;
+    std::vector<char*> blocks_;
+    FreeNode* free_list_ = nullptr;
+    // Ещё не выданная часть последнего блока
+    char* cursor_ = nullptr;
+    char* block_end_ = nullptr;
+    size_t allocated_ = 0;
+};
+
+// Аллокатор узлов списка поверх NodePool: соседние узлы лежат рядом в памяти,
+// а вставка и удаление обходятся без обращений к malloc.
+// Копии аллокатора и его перепривязки к другим типам разделяют один пул. Кусками пула выдаются
+// одиночные объекты того типа, который выделяется первым (у списка - узлы), остальные запросы
+// идут к operator new. Копия списка получает собственный пул.
+// Пул не потокобезопасен, как и сам список
+template <typename Type, size_t NodesPerBlock = 256>
+class PoolAllocator {
+    static_assert(NodesPerBlock > 0);
+
+    template <typename Other, size_t OtherNodesPerBlock>
+    friend class PoolAllocator;
+
+public:
+    using value_type = Type;
+    // Узлы можно вернуть только в тот пул, из которого они взяты, поэтому пул следует за ними
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    template <typename Other>
+    struct rebind {
+        using other = PoolAllocator<Other, NodesPerBlock>;
+    };
+
+    PoolAllocator()
+        : pool_(std::make_shared<NodePool>(NodesPerBlock)) {
+    }
+
+    // Перемещение тоже копирует, чтобы исходный аллокатор оставался рабочим
+    PoolAllocator(const PoolAllocator& other) noexcept = default;
+    PoolAllocator& operator=(const PoolAllocator& other) noexcept = default;
+
+    template <typename Other>
+    PoolAllocator(const PoolAllocator<Other, NodesPerBlock>& other) noexcept
+        : pool_(other.pool_) {
+    }
+
+    // Контейнер, созданный копированием, заводит собственный пул
+    PoolAllocator select_on_container_copy_construction() const {
+        return PoolAllocator();
+    }
+
+    Type* allocate(size_t count) {
+        if (count != 1 || !pool_->Fits(sizeof(Type), alignof(Type))) {
+            return std::allocator<Type>().allocate(count);
+        }
+        return static_cast<Type*>(pool_->Allocate());
+    }
+
+    void deallocate(Type* ptr, size_t count) noexcept {
+        if (count != 1 || !pool_->Fits(sizeof(Type), alignof(Type))) {
+            std::allocator<Type>().deallocate(ptr, count);
+            return;
+        }
+        pool_->Deallocate(ptr);
+    }
+
+    // Сколько кусков выдано и ещё не возвращено
+    size_t GetAllocatedCount() const noexcept {
+        return pool_->GetAllocatedCount();
+    }
+
+    size_t GetBlockCount() const noexcept {
+        return pool_->GetBlockCount();
+    }
+
+    // Возвращает все блоки разом. Выданные куски становятся недействительными, поэтому
+    // вызывать можно, только когда их объекты уже разрушены или разрушать их не нужно
+    void Release() noexcept {
+        pool_->Release();
+    }
+
+    template <typename Other>
+    bool operator==(const PoolAllocator<Other, NodesPerBlock>& other) const noexcept {
+        return pool_ == other.pool_;
+    }
+
+    template <typename Other>
+    bool operator!=(const PoolAllocator<Other, NodesPerBlock>& other) const noexcept {
+        return pool_ != other.pool_;
+    }
+
+private:
+    std::shared_ptr<NodePool> pool_;
+};
+
+// Аллокаторы с методами Release() и GetAllocatedCount() умеют освобождать память блоками
+template <typename Allocator, typename = void>
+struct IsPoolAllocator : std::false_type {
+};
+
+template <typename Allocator>
+struct IsPoolAllocator<Allocator, std::void_t<decltype(std::declval<Allocator&>().Release()),
+                                              decltype(std::declval<const Allocator&>().GetAllocatedCount())>>
+    : std::true_type {
+};
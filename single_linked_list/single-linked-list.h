@@ -2,29 +2,49 @@
 
 #include <cassert>
 #include <cstddef>
+#include <functional>
 #include <string>
 #include <utility>
 #include <iterator>
-#include <vector>
+#include <memory>
+#include <type_traits>
+#include "node_pool.h"
 
-template <typename Type>
+// Односвязный список. Узлы выделяются аллокатором Allocator, перепривязанным к типу узла;
+// PoolAllocator из node_pool.h нарезает их из общих блоков и переиспользует удалённые
+template <typename Type, typename Allocator = std::allocator<Type>>
 class SingleLinkedList {
     
-    struct Node {
-        Node() = default;
-        Node(const Type& val, Node* next)
-            : value(val)
-            , next_node(next) {
+    struct Node;
+
+    // Фиктивный узел перед первым элементом хранит только ссылку, поэтому элементам
+    // не нужен конструктор по умолчанию
+    struct NodeBase {
+        Node* next_node = nullptr;
+    };
+
+    struct Node : NodeBase {
+        // Элемент создаётся прямо в узле из переданных аргументов
+        template <typename... Args>
+        Node(Node* next, Args&&... args)
+            : NodeBase{next}
+            , value(std::forward<Args>(args)...) {
         }
         Type value;
-        Node* next_node = nullptr;
     };
+
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+    template <typename InputIt>
+    using RequireInputIterator = std::enable_if_t<std::is_base_of_v<std::input_iterator_tag,
+        typename std::iterator_traits<InputIt>::iterator_category>>;
     
     template<typename ValueType>
     class BasicIterator {
         friend class SingleLinkedList;
         
-        explicit BasicIterator(Node* node) 
+        explicit BasicIterator(NodeBase* node) 
         : node_(node)
         {
         }
@@ -74,32 +94,53 @@ class SingleLinkedList {
             
             [[nodiscard]] reference operator*() const noexcept {
                 assert(this->node_ != nullptr);
-                return this->node_->value;
+                return static_cast<Node*>(this->node_)->value;
             }
             
             [[nodiscard]] pointer operator->() const noexcept {
                 assert(this->node_ != nullptr);
-                return &this->node_->value;
+                return &static_cast<Node*>(this->node_)->value;
             }
         private:
-            Node* node_ = nullptr;
+            NodeBase* node_ = nullptr;
     };
 
 public:
 
     using value_type = Type;
+    using allocator_type = Allocator;
     using reference = value_type&;
     using const_reference = const value_type&;
     using Iterator = BasicIterator<Type>;
     using ConstIterator = BasicIterator<const Type>;
     
-    SingleLinkedList(std::initializer_list<Type> values) {
+    SingleLinkedList() = default;
+
+    explicit SingleLinkedList(const Allocator& alloc)
+        : node_alloc_(alloc) {
+    }
+
+    SingleLinkedList(std::initializer_list<Type> values, const Allocator& alloc = Allocator())
+        : node_alloc_(alloc) {
         Copy(values.begin(), values.end());
     }
+
+    template <typename InputIt, typename = RequireInputIterator<InputIt>>
+    SingleLinkedList(InputIt first, InputIt last, const Allocator& alloc = Allocator())
+        : node_alloc_(alloc) {
+        Copy(first, last);
+    }
     
-    SingleLinkedList(const SingleLinkedList& other) {
+    SingleLinkedList(const SingleLinkedList& other)
+        : node_alloc_(NodeTraits::select_on_container_copy_construction(other.node_alloc_)) {
         Copy(other.begin(), other.end());
     }
+
+    // Узлы переходят к новому списку вместе с аллокатором, other остаётся пустым
+    SingleLinkedList(SingleLinkedList&& other) noexcept
+        : node_alloc_(std::move(other.node_alloc_)) {
+        StealNodes(other);
+    }
     
     SingleLinkedList& operator=(const SingleLinkedList& rhs) {
         if (this != &rhs) {
@@ -108,17 +149,40 @@ public:
         }
         return *this;
     }
+
+    // Узлы забираются целиком, если аллокатор переходит вместе с ними или аллокаторы равны.
+    // Иначе узлы rhs нельзя освободить своим аллокатором, и элементы перемещаются по одному
+    SingleLinkedList& operator=(SingleLinkedList&& rhs) noexcept(
+        NodeTraits::propagate_on_container_move_assignment::value || NodeTraits::is_always_equal::value) {
+        if (this == &rhs) {
+            return *this;
+        }
+        Clear();
+        if constexpr (NodeTraits::propagate_on_container_move_assignment::value) {
+            node_alloc_ = std::move(rhs.node_alloc_);
+            StealNodes(rhs);
+        } else if (NodeTraits::is_always_equal::value || node_alloc_ == rhs.node_alloc_) {
+            StealNodes(rhs);
+        } else {
+            auto pos = cbefore_begin();
+            for (Type& value : rhs) {
+                pos = EmplaceAfter(pos, std::move(value));
+            }
+            rhs.Clear();
+        }
+        return *this;
+    }
     
     void swap(SingleLinkedList& other) noexcept {
+        if constexpr (NodeTraits::propagate_on_container_swap::value) {
+            using std::swap;
+            swap(node_alloc_, other.node_alloc_);
+        }
         std::swap(this->size_, other.size_);
         std::swap(this->head_.next_node, other.head_.next_node);
     }
     
-    SingleLinkedList<Type>() {
-            size_ = 0;
-        }
-        
-    ~SingleLinkedList<Type>() {
+    ~SingleLinkedList() {
         Clear();
     }
     // Возвращает количество элементов в списке за время O(1)
@@ -132,17 +196,43 @@ public:
     }
     
     void PushFront(const Type& value) {
-       head_.next_node = new Node(value, head_.next_node);
-       size_++;
+        EmplaceFront(value);
+    }
+
+    void PushFront(Type&& value) {
+        EmplaceFront(std::move(value));
+    }
+
+    template <typename... Args>
+    Type& EmplaceFront(Args&&... args) {
+        head_.next_node = CreateNode(head_.next_node, std::forward<Args>(args)...);
+        size_++;
+        return head_.next_node->value;
     }
     
+    // С пулом узлов, в котором нет чужих узлов, тривиально разрушаемые элементы не обходятся вовсе:
+    // пул возвращает все блоки разом. Иначе узлы удаляются по одному, а опустевший пул
+    // всё равно отдаёт блоки
     void Clear() noexcept {
+        if constexpr (IsPoolAllocator<NodeAllocator>::value && std::is_trivially_destructible_v<Type>) {
+            if (node_alloc_.GetAllocatedCount() == size_) {
+                node_alloc_.Release();
+                head_.next_node = nullptr;
+                size_ = 0;
+                return;
+            }
+        }
         while(head_.next_node != nullptr) {
             Node* temp = head_.next_node;
             head_.next_node = head_.next_node->next_node;
-            delete temp;
+            DestroyNode(temp);
         }
         size_ = 0;
+        if constexpr (IsPoolAllocator<NodeAllocator>::value) {
+            if (node_alloc_.GetAllocatedCount() == 0) {
+                node_alloc_.Release();
+            }
+        }
     }
     
     [[nodiscard]] Iterator begin() noexcept {
@@ -170,21 +260,30 @@ public:
     }
     
     [[nodiscard]] Iterator before_begin() noexcept {
-        return Iterator{const_cast<Node*>(&head_)};
+        return Iterator{const_cast<NodeBase*>(&head_)};
     }
     
     [[nodiscard]] ConstIterator cbefore_begin() const noexcept {
-        return ConstIterator{const_cast<Node*>(&head_)};
+        return ConstIterator{const_cast<NodeBase*>(&head_)};
     }
     
     [[nodiscard]] ConstIterator before_begin() const noexcept {
-        return ConstIterator{const_cast<Node*>(&head_)};
+        return ConstIterator{const_cast<NodeBase*>(&head_)};
     }
     
     Iterator InsertAfter(ConstIterator pos, const Type& value) {
+        return EmplaceAfter(pos, value);
+    }
+
+    Iterator InsertAfter(ConstIterator pos, Type&& value) {
+        return EmplaceAfter(pos, std::move(value));
+    }
+
+    // Если конструктор элемента бросит исключение, список не изменится
+    template <typename... Args>
+    Iterator EmplaceAfter(ConstIterator pos, Args&&... args) {
         assert(pos.node_ != nullptr);
-        auto X = new Node(value, pos.node_);
-        X->next_node = pos.node_->next_node;
+        auto X = CreateNode(pos.node_->next_node, std::forward<Args>(args)...);
         pos.node_->next_node = X;
         ++size_;
         return Iterator{pos.node_->next_node};
@@ -193,7 +292,7 @@ public:
     void PopFront() noexcept {
         assert(size_ != 0);
         auto tmp = head_.next_node->next_node;
-        delete head_.next_node;
+        DestroyNode(head_.next_node);
         head_.next_node = tmp;
         size_--;
     }
@@ -202,208 +301,242 @@ public:
         assert(pos.node_ != nullptr);
         assert(size_ != 0);
         auto tmp = pos.node_->next_node->next_node;
-        delete pos.node_->next_node;
+        DestroyNode(pos.node_->next_node);
         pos.node_->next_node = tmp;
-        return Iterator{pos.node_->next_node};
         size_--;
+        return Iterator{pos.node_->next_node};
     }
     
+    // Заменяет содержимое элементами диапазона за один проход: каждый элемент копируется один раз
+    // сразу в узел, который дописывается в хвост. Если копирование бросит исключение,
+    // список не изменится
     template <typename IteratorType>
     void Copy(IteratorType begin, IteratorType end) {
-        std::vector<Type> tmp;
+        // Узлы берутся у того же аллокатора узлов, чтобы после обмена остаться в своём пуле
+        SingleLinkedList s_tmp(WithNodeAllocator{}, node_alloc_);
+        auto tail = s_tmp.cbefore_begin();
         for (auto it = begin; it != end; ++it) {
-            tmp.push_back(*it);
-        }
-        SingleLinkedList s_tmp;
-        for (auto it = tmp.rbegin(); it != tmp.rend(); ++it) {
-            s_tmp.PushFront(*it);
+            tail = s_tmp.EmplaceAfter(tail, *it);
         }
         swap(s_tmp);
     }
 
-private:
-    // Фиктивный узел, используется для вставки "перед первым элементом"
-    Node head_;
-    size_t size_;
-};
-
-template <typename Type>
-void swap(SingleLinkedList<Type>& lhs, SingleLinkedList<Type>& rhs) noexcept {
-    lhs.swap(rhs);
-}
-
-template <typename Type>
-bool operator==(const SingleLinkedList<Type>& lhs, const SingleLinkedList<Type>& rhs) {
-    return std::equal(lhs.begin(), lhs.end(), rhs.begin());
-}
+    // Операции ниже переставляют существующие узлы: элементы не копируются, память не выделяется,
+    // итераторы и ссылки на перенесённые элементы остаются действительными.
+    // Узлы переходят между списками, только если их аллокаторы равны
 
-template <typename Type>
-bool operator!=(const SingleLinkedList<Type>& lhs, const SingleLinkedList<Type>& rhs) {
-    return !operator==(lhs, rhs);
-}
+    // Переносит все элементы other после pos. Время - O(other.GetSize()) на поиск хвоста other
+    void SpliceAfter(ConstIterator pos, SingleLinkedList& other) noexcept {
+        assert(this != &other);
+        assert(node_alloc_ == other.node_alloc_);
+        if (other.IsEmpty()) {
+            return;
+        }
+        NodeBase* last = &other.head_;
+        while (last->next_node != nullptr) {
+            last = last->next_node;
+        }
+        Relink(pos.node_, &other.head_, last);
+        size_ += std::exchange(other.size_, 0);
+    }
 
-template <typename Type>
-bool operator<(const SingleLinkedList<Type>& lhs, const SingleLinkedList<Type>& rhs) {
-    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
-}
+    // Переносит элемент, следующий за it в other, на место после pos. Время - O(1)
+    void SpliceAfter(ConstIterator pos, SingleLinkedList& other, ConstIterator it) noexcept {
+        assert(it.node_ != nullptr && it.node_->next_node != nullptr);
+        assert(this == &other || node_alloc_ == other.node_alloc_);
+        if (pos.node_ == it.node_ || pos.node_ == it.node_->next_node) {
+            return;
+        }
+        Relink(pos.node_, it.node_, it.node_->next_node);
+        --other.size_;
+        ++size_;
+    }
 
-template <typename Type>
-bool operator<=(const SingleLinkedList<Type>& lhs, const SingleLinkedList<Type>& rhs) {
-    return !std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
-}
+    // Переносит элементы other из интервала (first, last) на место после pos. Время - O(длины интервала).
+    // pos не должен лежать внутри переносимого интервала
+    void SpliceAfter(ConstIterator pos, SingleLinkedList& other, ConstIterator first, ConstIterator last) noexcept {
+        assert(first.node_ != nullptr);
+        assert(this == &other || node_alloc_ == other.node_alloc_);
+        if (first.node_->next_node == last.node_) {
+            return;
+        }
+        NodeBase* tail = first.node_;
+        size_t count = 0;
+        while (tail->next_node != last.node_) {
+            tail = tail->next_node;
+            ++count;
+        }
+        Relink(pos.node_, first.node_, tail);
+        other.size_ -= count;
+        size_ += count;
+    }
 
-template <typename Type>
-bool operator>(const SingleLinkedList<Type>& lhs, const SingleLinkedList<Type>& rhs) {
-    return !operator<(lhs, rhs);
-}
+    // Сливает отсортированный other в этот отсортированный список за O(GetSize() + other.GetSize()).
+    // Слияние устойчиво: из равных элементов первыми идут элементы этого списка. other становится пустым,
+    // даже если сравнение бросит исключение: тогда все узлы остаются в этом списке в неопределённом порядке
+    template <typename Compare>
+    void Merge(SingleLinkedList& other, Compare comp) {
+        if (this == &other) {
+            return;
+        }
+        assert(node_alloc_ == other.node_alloc_);
+        Node* right = std::exchange(other.head_.next_node, nullptr);
+        size_ += std::exchange(other.size_, 0);
+        MergeChains(&head_, head_.next_node, right, comp);
+    }
 
-template <typename Type>
-bool operator>=(const SingleLinkedList<Type>& lhs, const SingleLinkedList<Type>& rhs) {
-    return !std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
-} 
+    void Merge(SingleLinkedList& other) {
+        Merge(other, std::less<>());
+    }
 
-void Test4() {
-    struct DeletionSpy {
-        ~DeletionSpy() {
-            if (deletion_counter_ptr) {
-                ++(*deletion_counter_ptr);
+    // Устойчивая сортировка слиянием снизу вверх: соседние серии длиной 1, 2, 4, ... сливаются
+    // на месте перестановкой узлов. Время - O(n log n), дополнительная память - O(1)
+    template <typename Compare>
+    void Sort(Compare comp) {
+        for (size_t width = 1; width < size_; width *= 2) {
+            NodeBase* tail = &head_;
+            Node* rest = head_.next_node;
+            while (rest != nullptr) {
+                Node* left = rest;
+                Node* right = Cut(left, width);
+                rest = Cut(right, width);
+                try {
+                    tail = MergeChains(tail, left, right, comp);
+                } catch (...) {
+                    while (tail->next_node != nullptr) {
+                        tail = tail->next_node;
+                    }
+                    tail->next_node = rest;
+                    throw;
+                }
             }
         }
-        int* deletion_counter_ptr = nullptr;
+    }
+
+    void Sort() {
+        Sort(std::less<>());
+    }
+
+private:
+    struct WithNodeAllocator {
     };
 
-    // Проверка PopFront
-    {
-        SingleLinkedList<int> numbers{3, 14, 15, 92, 6};
-        numbers.PopFront();
-        assert((numbers == SingleLinkedList<int>{14, 15, 92, 6}));
-
-        SingleLinkedList<DeletionSpy> list;
-        list.PushFront(DeletionSpy{});
-        int deletion_counter = 0;
-        list.begin()->deletion_counter_ptr = &deletion_counter;
-        assert(deletion_counter == 0);
-        list.PopFront();
-        assert(deletion_counter == 1);
-    }
-
-    // Доступ к позиции, предшествующей begin
-    {
-        SingleLinkedList<int> empty_list;
-        const auto& const_empty_list = empty_list;
-        assert(empty_list.before_begin() == empty_list.cbefore_begin());
-        assert(++empty_list.before_begin() == empty_list.begin());
-        assert(++empty_list.cbefore_begin() == const_empty_list.begin());
-
-        SingleLinkedList<int> numbers{1, 2, 3, 4};
-        const auto& const_numbers = numbers;
-        assert(numbers.before_begin() == numbers.cbefore_begin());
-        assert(++numbers.before_begin() == numbers.begin());
-        assert(++numbers.cbefore_begin() == const_numbers.begin());
-    }
-
-    // Вставка элемента после указанной позиции
-    {  // Вставка в пустой список
-        {
-            SingleLinkedList<int> lst;
-            const auto inserted_item_pos = lst.InsertAfter(lst.before_begin(), 123);
-            assert((lst == SingleLinkedList<int>{123}));
-            assert(inserted_item_pos == lst.begin());
-            assert(*inserted_item_pos == 123);
+    // Пустой список с копией готового аллокатора узлов: аллокатор по умолчанию не создаётся
+    SingleLinkedList(WithNodeAllocator, const NodeAllocator& node_alloc)
+        : node_alloc_(node_alloc) {
+    }
+
+    template <typename... Args>
+    Node* CreateNode(Node* next, Args&&... args) {
+        Node* node = NodeTraits::allocate(node_alloc_, 1);
+        try {
+            NodeTraits::construct(node_alloc_, node, next, std::forward<Args>(args)...);
+        } catch (...) {
+            NodeTraits::deallocate(node_alloc_, node, 1);
+            throw;
         }
+        return node;
+    }
 
-        // Вставка в непустой список
-        {
-            SingleLinkedList<int> lst{1, 2, 3};
-            auto inserted_item_pos = lst.InsertAfter(lst.before_begin(), 123);
-
-            assert(inserted_item_pos == lst.begin());
-            assert(inserted_item_pos != lst.end());
-            assert(*inserted_item_pos == 123);
-            assert((lst == SingleLinkedList<int>{123, 1, 2, 3}));
-
-            inserted_item_pos = lst.InsertAfter(lst.begin(), 555);
-            assert(++SingleLinkedList<int>::Iterator(lst.begin()) == inserted_item_pos);
-            assert(*inserted_item_pos == 555);
-            assert((lst == SingleLinkedList<int>{123, 555, 1, 2, 3}));
-        };
-    }
-
-    // Вспомогательный класс, бросающий исключение после создания N-копии
-    struct ThrowOnCopy {
-        ThrowOnCopy() = default;
-        explicit ThrowOnCopy(int& copy_counter) noexcept
-            : countdown_ptr(&copy_counter) {
+    // Забирает узлы other; свои узлы к этому моменту уже удалены
+    void StealNodes(SingleLinkedList& other) noexcept {
+        head_.next_node = std::exchange(other.head_.next_node, nullptr);
+        size_ = std::exchange(other.size_, 0);
+    }
+
+    // Вырезает узлы (before, last] и вставляет их после pos
+    static void Relink(NodeBase* pos, NodeBase* before, NodeBase* last) noexcept {
+        Node* first = before->next_node;
+        before->next_node = last->next_node;
+        last->next_node = pos->next_node;
+        pos->next_node = first;
+    }
+
+    // Отрезает цепочку после count узлов и возвращает её начало
+    static Node* Cut(Node* chain, size_t count) noexcept {
+        for (size_t i = 1; chain != nullptr && i < count; ++i) {
+            chain = chain->next_node;
         }
-        ThrowOnCopy(const ThrowOnCopy& other)
-            : countdown_ptr(other.countdown_ptr)  //
-        {
-            if (countdown_ptr) {
-                if (*countdown_ptr == 0) {
-                    throw std::bad_alloc();
+        if (chain == nullptr) {
+            return nullptr;
+        }
+        return std::exchange(chain->next_node, nullptr);
+    }
+
+    // Сливает отсортированные цепочки left и right, подвешивает результат к tail
+    // и возвращает последний узел результата
+    template <typename Compare>
+    static NodeBase* MergeChains(NodeBase* tail, Node* left, Node* right, Compare& comp) {
+        try {
+            while (left != nullptr && right != nullptr) {
+                if (comp(right->value, left->value)) {
+                    tail->next_node = right;
+                    right = right->next_node;
                 } else {
-                    --(*countdown_ptr);
+                    tail->next_node = left;
+                    left = left->next_node;
                 }
+                tail = tail->next_node;
             }
-        }
-        // Присваивание элементов этого типа не требуется
-        ThrowOnCopy& operator=(const ThrowOnCopy& rhs) = delete;
-        // Адрес счётчика обратного отсчёта. Если не равен nullptr, то уменьшается при каждом копировании.
-        // Как только обнулится, конструктор копирования выбросит исключение
-        int* countdown_ptr = nullptr;
-    };
-
-    // Проверка обеспечения строгой гарантии безопасности исключений
-    {
-        bool exception_was_thrown = false;
-        for (int max_copy_counter = 10; max_copy_counter >= 0; --max_copy_counter) {
-            SingleLinkedList<ThrowOnCopy> list{ThrowOnCopy{}, ThrowOnCopy{}, ThrowOnCopy{}};
-            try {
-                int copy_counter = max_copy_counter;
-                list.InsertAfter(list.cbegin(), ThrowOnCopy(copy_counter));
-                assert(list.GetSize() == 4u);
-            } catch (const std::bad_alloc&) {
-                exception_was_thrown = true;
-                assert(list.GetSize() == 3u);
-                break;
+        } catch (...) {
+            // Если сравнение бросило исключение, остатки обеих цепочек подвешиваются к результату:
+            // порядок не определён, но узлы не теряются
+            tail->next_node = left;
+            while (tail->next_node != nullptr) {
+                tail = tail->next_node;
             }
+            tail->next_node = right;
+            throw;
         }
-        assert(exception_was_thrown);
+        tail->next_node = left != nullptr ? left : right;
+        while (tail->next_node != nullptr) {
+            tail = tail->next_node;
+        }
+        return tail;
     }
 
-    // Удаление элементов после указанной позиции
-    {
-        {
-            SingleLinkedList<int> lst{1, 2, 3, 4};
-            const auto& const_lst = lst;
-            const auto item_after_erased = lst.EraseAfter(const_lst.cbefore_begin());
-            assert((lst == SingleLinkedList<int>{2, 3, 4}));
-            assert(item_after_erased == lst.begin());
-        }
-        {
-            SingleLinkedList<int> lst{1, 2, 3, 4};
-            const auto item_after_erased = lst.EraseAfter(lst.cbegin());
-            assert((lst == SingleLinkedList<int>{1, 3, 4}));
-            assert(item_after_erased == (++lst.begin()));
-        }
-        {
-            SingleLinkedList<int> lst{1, 2, 3, 4};
-            const auto item_after_erased = lst.EraseAfter(++(++lst.cbegin()));
-            assert((lst == SingleLinkedList<int>{1, 2, 3}));
-            assert(item_after_erased == lst.end());
-        }
-        {
-            SingleLinkedList<DeletionSpy> list{DeletionSpy{}, DeletionSpy{}, DeletionSpy{}};
-            auto after_begin = ++list.begin();
-            int deletion_counter = 0;
-            after_begin->deletion_counter_ptr = &deletion_counter;
-            assert(deletion_counter == 0u);
-            list.EraseAfter(list.cbegin());
-            assert(deletion_counter == 1u);
-        }
+    void DestroyNode(Node* node) noexcept {
+        NodeTraits::destroy(node_alloc_, node);
+        NodeTraits::deallocate(node_alloc_, node, 1);
     }
+
+    // Фиктивный узел, используется для вставки "перед первым элементом"
+    NodeBase head_;
+    size_t size_ = 0;
+    NodeAllocator node_alloc_;
+};
+
+template <typename Type, typename Allocator>
+void swap(SingleLinkedList<Type, Allocator>& lhs, SingleLinkedList<Type, Allocator>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+template <typename Type, typename Allocator>
+bool operator==(const SingleLinkedList<Type, Allocator>& lhs, const SingleLinkedList<Type, Allocator>& rhs) {
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename Type, typename Allocator>
+bool operator!=(const SingleLinkedList<Type, Allocator>& lhs, const SingleLinkedList<Type, Allocator>& rhs) {
+    return !operator==(lhs, rhs);
+}
+
+template <typename Type, typename Allocator>
+bool operator<(const SingleLinkedList<Type, Allocator>& lhs, const SingleLinkedList<Type, Allocator>& rhs) {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-int main() {
-    Test4();
+template <typename Type, typename Allocator>
+bool operator<=(const SingleLinkedList<Type, Allocator>& lhs, const SingleLinkedList<Type, Allocator>& rhs) {
+    return !std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename Type, typename Allocator>
+bool operator>(const SingleLinkedList<Type, Allocator>& lhs, const SingleLinkedList<Type, Allocator>& rhs) {
+    return !operator<(lhs, rhs);
+}
+
+template <typename Type, typename Allocator>
+bool operator>=(const SingleLinkedList<Type, Allocator>& lhs, const SingleLinkedList<Type, Allocator>& rhs) {
+    return !std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
@@ -0,0 +1,400 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Сколько элементов помещается в узел размером около двух кеш-линий
+template <typename Type>
+constexpr size_t DefaultNodeCapacity() noexcept {
+    constexpr size_t NODE_BYTES = 128;
+    constexpr size_t HEADER_BYTES = sizeof(void*) + sizeof(size_t);
+    return sizeof(Type) * 4 <= NODE_BYTES - HEADER_BYTES ? (NODE_BYTES - HEADER_BYTES) / sizeof(Type) : 4;
+}
+
+// Развёрнутый односвязный список: в узле лежат до NodeCapacity элементов подряд, поэтому обход
+// читает память последовательно, а указатель на следующий узел приходится на несколько элементов.
+// Интерфейс как у SingleLinkedList: однонаправленные итераторы, before_begin, InsertAfter и EraseAfter.
+// Переполненный узел делится пополам, а узел, заполненный меньше чем наполовину, сливается
+// со следующим, если их элементы помещаются в один узел.
+// В отличие от SingleLinkedList, вставка и удаление сдвигают элементы внутри узла и могут
+// перенести их в другой узел: итераторы на элементы затронутых узлов становятся недействительными
+template <typename Type, size_t NodeCapacity = DefaultNodeCapacity<Type>()>
+class UnrolledList {
+    static_assert(NodeCapacity >= 2);
+
+    struct NodeBase {
+        NodeBase* next_node = nullptr;
+        size_t count = 0;
+    };
+
+    struct Node : NodeBase {
+        Type* Data() noexcept {
+            return std::launder(reinterpret_cast<Type*>(storage));
+        }
+
+        alignas(Type) unsigned char storage[sizeof(Type) * NodeCapacity];
+    };
+
+    template <typename ValueType>
+    class BasicIterator {
+        friend class UnrolledList;
+        template <typename OtherValueType>
+        friend class BasicIterator;
+
+        BasicIterator(NodeBase* node, size_t index) noexcept
+            : node_(node)
+            , index_(index) {
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = ValueType*;
+        using reference = ValueType&;
+
+        BasicIterator() = default;
+
+        BasicIterator(const BasicIterator<Type>& other) noexcept
+            : node_(other.node_)
+            , index_(other.index_) {
+        }
+
+        BasicIterator& operator=(const BasicIterator& rhs) = default;
+
+        [[nodiscard]] bool operator==(const BasicIterator<const Type>& rhs) const noexcept {
+            return node_ == rhs.node_ && index_ == rhs.index_;
+        }
+
+        [[nodiscard]] bool operator!=(const BasicIterator<const Type>& rhs) const noexcept {
+            return !(*this == rhs);
+        }
+
+        [[nodiscard]] bool operator==(const BasicIterator<Type>& rhs) const noexcept {
+            return node_ == rhs.node_ && index_ == rhs.index_;
+        }
+
+        [[nodiscard]] bool operator!=(const BasicIterator<Type>& rhs) const noexcept {
+            return !(*this == rhs);
+        }
+
+        // Фиктивный узел пуст, поэтому before_begin сразу переходит к первому элементу
+        BasicIterator& operator++() noexcept {
+            assert(node_ != nullptr);
+            if (++index_ >= node_->count) {
+                node_ = node_->next_node;
+                index_ = 0;
+            }
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            auto old_value(*this);
+            ++(*this);
+            return old_value;
+        }
+
+        [[nodiscard]] reference operator*() const noexcept {
+            assert(node_ != nullptr && index_ < node_->count);
+            return static_cast<Node*>(node_)->Data()[index_];
+        }
+
+        [[nodiscard]] pointer operator->() const noexcept {
+            return &**this;
+        }
+
+    private:
+        NodeBase* node_ = nullptr;
+        size_t index_ = 0;
+    };
+
+public:
+    using value_type = Type;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using Iterator = BasicIterator<Type>;
+    using ConstIterator = BasicIterator<const Type>;
+
+    static constexpr size_t NODE_CAPACITY = NodeCapacity;
+
+    UnrolledList() = default;
+
+    // Конструкторы ниже делегируют конструктору по умолчанию: если копирование элемента бросит
+    // исключение, деструктор удалит уже созданные узлы
+    UnrolledList(std::initializer_list<Type> values)
+        : UnrolledList() {
+        Append(values.begin(), values.end());
+    }
+
+    UnrolledList(const UnrolledList& other)
+        : UnrolledList() {
+        Append(other.begin(), other.end());
+    }
+
+    // Перемещение забирает узлы целиком, other остаётся пустым
+    UnrolledList(UnrolledList&& other) noexcept {
+        swap(other);
+    }
+
+    UnrolledList& operator=(const UnrolledList& rhs) {
+        if (this != &rhs) {
+            auto rhscopy(rhs);
+            swap(rhscopy);
+        }
+        return *this;
+    }
+
+    UnrolledList& operator=(UnrolledList&& rhs) noexcept {
+        if (this != &rhs) {
+            UnrolledList moved(std::move(rhs));
+            swap(moved);
+        }
+        return *this;
+    }
+
+    ~UnrolledList() {
+        Clear();
+    }
+
+    void swap(UnrolledList& other) noexcept {
+        std::swap(size_, other.size_);
+        std::swap(head_.next_node, other.head_.next_node);
+    }
+
+    [[nodiscard]] size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    [[nodiscard]] bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    void PushFront(const Type& value) {
+        InsertAfter(cbefore_begin(), value);
+    }
+
+    void PopFront() noexcept {
+        assert(size_ != 0);
+        EraseAfter(cbefore_begin());
+    }
+
+    void Clear() noexcept {
+        while (head_.next_node != nullptr) {
+            Node* node = AsNode(head_.next_node);
+            head_.next_node = node->next_node;
+            std::destroy_n(node->Data(), node->count);
+            delete node;
+        }
+        size_ = 0;
+    }
+
+    [[nodiscard]] Iterator begin() noexcept {
+        return Iterator{head_.next_node, 0};
+    }
+
+    [[nodiscard]] Iterator end() noexcept {
+        return Iterator{nullptr, 0};
+    }
+
+    [[nodiscard]] ConstIterator begin() const noexcept {
+        return ConstIterator{head_.next_node, 0};
+    }
+
+    [[nodiscard]] ConstIterator end() const noexcept {
+        return ConstIterator{nullptr, 0};
+    }
+
+    [[nodiscard]] ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    [[nodiscard]] ConstIterator cend() const noexcept {
+        return end();
+    }
+
+    [[nodiscard]] Iterator before_begin() noexcept {
+        return Iterator{&head_, 0};
+    }
+
+    [[nodiscard]] ConstIterator before_begin() const noexcept {
+        return ConstIterator{const_cast<NodeBase*>(&head_), 0};
+    }
+
+    [[nodiscard]] ConstIterator cbefore_begin() const noexcept {
+        return before_begin();
+    }
+
+    // Если копирование значения бросит исключение, список не изменится
+    Iterator InsertAfter(ConstIterator pos, const Type& value) {
+        assert(pos.node_ != nullptr);
+        NodeBase* node = pos.node_;
+        size_t index = pos.index_ + 1;
+        if (node == &head_) {
+            // Перед первым элементом: в начало первого узла
+            if (head_.next_node == nullptr) {
+                return InsertIntoEmpty(value);
+            }
+            node = head_.next_node;
+            index = 0;
+        }
+        Node* target = AsNode(node);
+        if (target->count == NodeCapacity) {
+            Type copy(value);
+            Node* upper = Split(target);
+            if (index > target->count) {
+                index -= target->count;
+                target = upper;
+            }
+            InsertIntoNode(target, index, std::move(copy));
+        } else {
+            InsertIntoNode(target, index, value);
+        }
+        return Iterator{target, index};
+    }
+
+    Iterator EraseAfter(ConstIterator pos) noexcept {
+        assert(pos.node_ != nullptr);
+        assert(size_ != 0);
+        ConstIterator erased = std::next(pos);
+        assert(erased.node_ != nullptr);
+        Node* node = AsNode(erased.node_);
+        size_t index = erased.index_;
+        Type* data = node->Data();
+        std::move(data + index + 1, data + node->count, data + index);
+        std::destroy_at(data + node->count - 1);
+        --node->count;
+        --size_;
+        if (node->count == 0) {
+            // Пустым узел становится, только если удалён его первый элемент, и тогда pos указывает
+            // в предыдущий узел
+            pos.node_->next_node = node->next_node;
+            delete node;
+            return Iterator{pos.node_->next_node, 0};
+        }
+        if (node->count < NodeCapacity / 2) {
+            MergeWithNext(node);
+        }
+        if (index < node->count) {
+            return Iterator{node, index};
+        }
+        return Iterator{node->next_node, 0};
+    }
+
+private:
+    static Node* AsNode(NodeBase* node) noexcept {
+        return static_cast<Node*>(node);
+    }
+
+    Iterator InsertIntoEmpty(const Type& value) {
+        Node* created = new Node;
+        try {
+            new (created->Data()) Type(value);
+        } catch (...) {
+            delete created;
+            throw;
+        }
+        created->count = 1;
+        head_.next_node = created;
+        ++size_;
+        return Iterator{created, 0};
+    }
+
+    // Вставляет элемент в узел со свободным местом, сдвигая хвост узла вправо. Элемент, созданный
+    // за концом узла, сразу учитывается в узле и в размере списка: если сдвиг бросит, он не потеряется
+    template <typename Value>
+    void InsertIntoNode(Node* node, size_t index, Value&& value) {
+        assert(node->count < NodeCapacity && index <= node->count);
+        Type* data = node->Data();
+        if (index == node->count) {
+            new (data + index) Type(std::forward<Value>(value));
+            ++node->count;
+            ++size_;
+            return;
+        }
+        Type copy(std::forward<Value>(value));
+        new (data + node->count) Type(std::move(data[node->count - 1]));
+        ++node->count;
+        ++size_;
+        std::move_backward(data + index, data + node->count - 2, data + node->count - 1);
+        data[index] = std::move(copy);
+    }
+
+    // Переносит верхнюю половину полного узла в новый узел сразу за ним. Элементы перемещаются,
+    // если перемещение не бросает исключений, иначе копируются: при исключении узел не меняется,
+    // а новый узел освобождается, пока он ещё не связан со списком
+    static Node* Split(Node* node) {
+        auto upper = std::make_unique<Node>();
+        size_t keep = node->count / 2;
+        Type* data = node->Data();
+        if constexpr (std::is_nothrow_move_constructible_v<Type> || !std::is_copy_constructible_v<Type>) {
+            std::uninitialized_move(data + keep, data + node->count, upper->Data());
+        } else {
+            std::uninitialized_copy(data + keep, data + node->count, upper->Data());
+        }
+        std::destroy(data + keep, data + node->count);
+        upper->count = node->count - keep;
+        node->count = keep;
+        upper->next_node = node->next_node;
+        node->next_node = upper.get();
+        return upper.release();
+    }
+
+    // Забирает элементы следующего узла, если все они помещаются
+    static void MergeWithNext(Node* node) noexcept {
+        if (node->next_node == nullptr) {
+            return;
+        }
+        Node* next = AsNode(node->next_node);
+        if (node->count + next->count > NodeCapacity) {
+            return;
+        }
+        Type* from = next->Data();
+        std::uninitialized_move(from, from + next->count, node->Data() + node->count);
+        std::destroy_n(from, next->count);
+        node->count += next->count;
+        node->next_node = next->next_node;
+        delete next;
+    }
+
+    // Дописывает элементы в конец пустого списка, заполняя узлы целиком
+    template <typename InputIterator>
+    void Append(InputIterator first, InputIterator last) {
+        assert(size_ == 0);
+        NodeBase* tail = &head_;
+        for (; first != last; ++first) {
+            if (tail == &head_ || tail->count == NodeCapacity) {
+                tail->next_node = new Node;
+                tail = tail->next_node;
+            }
+            new (AsNode(tail)->Data() + tail->count) Type(*first);
+            ++tail->count;
+            ++size_;
+        }
+    }
+
+    // Фиктивный узел без элементов, используется для вставки "перед первым элементом"
+    NodeBase head_;
+    size_t size_ = 0;
+};
+
+template <typename Type, size_t NodeCapacity>
+void swap(UnrolledList<Type, NodeCapacity>& lhs, UnrolledList<Type, NodeCapacity>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+template <typename Type, size_t NodeCapacity>
+bool operator==(const UnrolledList<Type, NodeCapacity>& lhs, const UnrolledList<Type, NodeCapacity>& rhs) {
+    return lhs.GetSize() == rhs.GetSize() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename Type, size_t NodeCapacity>
+bool operator!=(const UnrolledList<Type, NodeCapacity>& lhs, const UnrolledList<Type, NodeCapacity>& rhs) {
+    return !(lhs == rhs);
+}